@@ -0,0 +1,84 @@
+#include "Bounds.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// ===================================================================
+// == Aabb Implementation
+// ===================================================================
+Aabb Aabb::fromPoints(const void* firstPosition, size_t count, size_t stride)
+{
+    if (count == 0) return Aabb();
+
+    Aabb box;
+    box.min = glm::vec3(std::numeric_limits<float>::max());
+    box.max = glm::vec3(-std::numeric_limits<float>::max());
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(firstPosition);
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec3 position;
+        std::memcpy(&position, bytes + i * stride, sizeof(glm::vec3));
+        box.min = glm::min(box.min, position);
+        box.max = glm::max(box.max, position);
+    }
+    return box;
+}
+
+Aabb Aabb::transformed(const glm::mat4& matrix) const
+{
+    // Arvo: the new extents are |M| applied to the old extents
+    const glm::vec3 c = center();
+    const glm::vec3 e = extents();
+
+    glm::vec3 newCenter(matrix[3][0], matrix[3][1], matrix[3][2]);
+    glm::vec3 newExtents(0.0f);
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            newCenter[row] += matrix[col][row] * c[col];
+            newExtents[row] += std::fabs(matrix[col][row]) * e[col];
+        }
+    }
+    return { newCenter - newExtents, newCenter + newExtents };
+}
+
+// ===================================================================
+// == Frustum Implementation
+// ===================================================================
+Frustum::Frustum(const glm::mat4& m, bool zeroToOneDepth)
+{
+    // Gribb/Hartmann plane extraction; glm is column-major so row i is m[*][i]
+    auto row = [&m](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+    const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    m_planes[0] = r3 + r0;                          // Left
+    m_planes[1] = r3 - r0;                          // Right
+    m_planes[2] = r3 + r1;                          // Bottom
+    m_planes[3] = r3 - r1;                          // Top
+    m_planes[4] = zeroToOneDepth ? r2 : r3 + r2;    // Near
+    m_planes[5] = r3 - r2;                          // Far
+
+    for (glm::vec4& plane : m_planes) {
+        const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f) {
+            plane = plane * (1.0f / length);
+        }
+    }
+}
+
+Frustum::Containment Frustum::classify(const Aabb& box) const
+{
+    const glm::vec3 center = box.center();
+    const glm::vec3 extents = box.extents();
+
+    Containment result = Inside;
+    for (const glm::vec4& plane : m_planes) {
+        // Signed distance of the centre against the box's projected radius
+        const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+        const float radius = std::fabs(plane.x) * extents.x + std::fabs(plane.y) * extents.y + std::fabs(plane.z) * extents.z;
+
+        if (distance < -radius) return Outside;
+        if (distance < radius) result = Intersects;
+    }
+    return result;
+}
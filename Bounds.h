@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+
+
+// ===================================================================
+// == Aabb Declaration
+// ===================================================================
+struct Aabb
+{
+    glm::vec3 min{ 0.0f };
+    glm::vec3 max{ 0.0f };
+
+    // Bounds of `count` positions that start every `stride` bytes (vertex buffers)
+    static Aabb fromPoints(const void* firstPosition, size_t count, size_t stride);
+
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    glm::vec3 extents() const { return (max - min) * 0.5f; }
+
+    float surfaceArea() const {
+        const glm::vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    bool contains(const Aabb& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z
+            && other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+    }
+
+    Aabb expanded(float margin) const { return { min - glm::vec3(margin), max + glm::vec3(margin) }; }
+
+    // Bounds of this box after transforming it by `matrix` (affine)
+    Aabb transformed(const glm::mat4& matrix) const;
+
+    static Aabb merge(const Aabb& a, const Aabb& b) {
+        return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+    }
+};
+
+
+// ===================================================================
+// == Frustum Declaration
+// ===================================================================
+// Six planes extracted from a view-projection matrix, normals pointing
+// inwards. Vulkan projections map depth to [0, 1], which is the default.
+class Frustum
+{
+public:
+    enum Containment { Outside, Intersects, Inside };
+
+    Frustum() = default;
+    explicit Frustum(const glm::mat4& viewProjection, bool zeroToOneDepth = true);
+
+    Containment classify(const Aabb& box) const;
+    bool intersects(const Aabb& box) const { return classify(box) != Outside; }
+
+private:
+    std::array<glm::vec4, 6> m_planes{};
+};
@@ -0,0 +1,134 @@
+#include "CaptureSession.h"
+#include "TraceRecorder.h"
+
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <cstring>
+
+// ===================================================================
+// == CaptureSession Implementation
+// ===================================================================
+CaptureSession::CaptureSession(const Settings& settings, QObject* parent)
+    : QObject(parent)
+    , m_settings(settings)
+    , m_freeSlots(qMax(1, settings.ringSize))
+{
+    m_ring.resize(qMax(1, settings.ringSize));
+    m_encoderPool.setMaxThreadCount(qMax(1, settings.encoderThreads));
+    QDir().mkpath(m_settings.directory);
+}
+
+CaptureSession::~CaptureSession()
+{
+    finish();
+}
+
+bool CaptureSession::submitFrame(const QImage& frame)
+{
+    ++m_submitted;
+    if (frame.isNull()) {
+        ++m_dropped;
+        return false;
+    }
+
+    // Backpressure: never queue more frames than the ring holds
+    if (m_settings.backpressure == BlockProducer) {
+        m_freeSlots.acquire();
+    }
+    else if (!m_freeSlots.tryAcquire()) {
+        ++m_dropped;
+        return false;
+    }
+
+    const int slot = acquireSlot();
+    QImage& buffer = m_ring[slot].image;
+
+    // Reuse the slot's pixel storage when the frame layout has not changed
+    if (buffer.size() != frame.size() || buffer.format() != frame.format()) {
+        buffer = QImage(frame.size(), frame.format());
+    }
+    const int rowBytes = qMin(buffer.bytesPerLine(), frame.bytesPerLine());
+    for (int y = 0; y < frame.height(); ++y) {
+        std::memcpy(buffer.scanLine(y), frame.constScanLine(y), rowBytes);
+    }
+
+    const quint64 frameIndex = m_nextFrameIndex++;
+    ++m_queued;
+
+    m_encoderPool.start([this, slot, frameIndex]() {
+        const bool success = writeFrame(m_ring[slot].image, frameIndex);
+        success ? ++m_written : ++m_failed;
+        --m_queued;
+        releaseSlot(slot);
+
+        QMetaObject::invokeMethod(this, [this, frameIndex, success]() {
+            emit frameWritten(frameIndex, success);
+            }, Qt::QueuedConnection);
+        });
+    return true;
+}
+
+void CaptureSession::finish()
+{
+    m_encoderPool.waitForDone();
+}
+
+CaptureSession::Stats CaptureSession::stats() const
+{
+    Stats result;
+    result.submitted = m_submitted;
+    result.written = m_written;
+    result.dropped = m_dropped;
+    result.failed = m_failed;
+    result.queued = m_queued;
+    return result;
+}
+
+int CaptureSession::acquireSlot()
+{
+    // A free slot is guaranteed by the semaphore
+    QMutexLocker locker(&m_slotMutex);
+    for (int i = 0; i < static_cast<int>(m_ring.size()); ++i) {
+        if (!m_ring[i].busy) {
+            m_ring[i].busy = true;
+            return i;
+        }
+    }
+    Q_UNREACHABLE();
+    return 0;
+}
+
+void CaptureSession::releaseSlot(int slot)
+{
+    {
+        QMutexLocker locker(&m_slotMutex);
+        m_ring[slot].busy = false;
+    }
+    m_freeSlots.release();
+}
+
+bool CaptureSession::writeFrame(const QImage& image, quint64 frameIndex) const
+{
+    TRACE_SCOPE("io", "captureEncode");
+    const QString number = QString("%1").arg(frameIndex, 6, 10, QChar('0'));
+    const QString extension = m_settings.format == Png ? "png" : "raw";
+    const QString path = QDir(m_settings.directory).filePath(
+        QString("%1_%2.%3").arg(m_settings.baseName, number, extension));
+
+    if (m_settings.format == Png) {
+        return image.save(path, "PNG");
+    }
+
+    // Raw: tightly packed rows in the image's own pixel format
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    const int rowBytes = image.width() * image.depth() / 8;
+    for (int y = 0; y < image.height(); ++y) {
+        if (file.write(reinterpret_cast<const char*>(image.constScanLine(y)), rowBytes) != rowBytes) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QObject>
+#include <QImage>
+#include <QMutex>
+#include <QSemaphore>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <vector>
+
+
+// ===================================================================
+// == CaptureSession Declaration
+// ===================================================================
+// Records a numbered image sequence (PNG or raw pixels) from frames
+// handed in by the editor. Frames are copied into a fixed ring of reused
+// buffers and encoded by a bounded pool of worker threads. When every
+// ring slot is still being encoded the session either drops the new
+// frame or blocks the caller, so memory never grows with the backlog.
+class CaptureSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Format { Png, Raw };
+    enum Backpressure { DropFrames, BlockProducer };
+
+    struct Settings {
+        QString directory;
+        QString baseName = "frame";
+        Format format = Png;
+        Backpressure backpressure = DropFrames;
+        int ringSize = 8;          // Frames that may be waiting for or in encoding
+        int encoderThreads = 2;
+    };
+
+    struct Stats {
+        quint64 submitted = 0;   // Frames offered by the caller
+        quint64 written = 0;     // Frames encoded and on disk
+        quint64 dropped = 0;     // Frames rejected because the ring was full
+        quint64 failed = 0;      // Frames that could not be written
+        int queued = 0;          // Frames currently waiting for or in encoding
+    };
+
+    explicit CaptureSession(const Settings& settings, QObject* parent = nullptr);
+    ~CaptureSession();
+
+    // Copies `frame` into a free ring slot and queues it; false if the frame was dropped
+    bool submitFrame(const QImage& frame);
+
+    // Waits for all queued frames to be written
+    void finish();
+
+    Stats stats() const;
+    const Settings& settings() const { return m_settings; }
+
+signals:
+    // Emitted (queued, on the session's thread) after each frame is written
+    void frameWritten(quint64 frameIndex, bool success);
+
+private:
+    struct Slot {
+        QImage image;
+        bool busy = false;
+    };
+
+    int acquireSlot();
+    void releaseSlot(int slot);
+    bool writeFrame(const QImage& image, quint64 frameIndex) const;
+
+    Settings m_settings;
+    QThreadPool m_encoderPool;
+    QSemaphore m_freeSlots;
+    mutable QMutex m_slotMutex;
+    std::vector<Slot> m_ring;
+    quint64 m_nextFrameIndex = 0;
+
+    std::atomic<quint64> m_submitted{ 0 };
+    std::atomic<quint64> m_written{ 0 };
+    std::atomic<quint64> m_dropped{ 0 };
+    std::atomic<quint64> m_failed{ 0 };
+    std::atomic<int> m_queued{ 0 };
+};
@@ -0,0 +1,236 @@
+#include "DynamicBvh.h"
+
+#include <algorithm>
+#include <cassert>
+
+// ===================================================================
+// == DynamicBvh Implementation
+// ===================================================================
+DynamicBvh::DynamicBvh(float fatMargin)
+    : m_fatMargin(fatMargin)
+{
+}
+
+int DynamicBvh::insert(const Aabb& box, int userData)
+{
+    const int leaf = allocateNode();
+    m_nodes[leaf].box = box.expanded(m_fatMargin);
+    m_nodes[leaf].userData = userData;
+    m_nodes[leaf].height = 0;
+
+    insertLeaf(leaf);
+    ++m_leafCount;
+    return leaf;
+}
+
+void DynamicBvh::remove(int proxy)
+{
+    assert(proxy >= 0 && proxy < static_cast<int>(m_nodes.size()) && m_nodes[proxy].isLeaf());
+
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --m_leafCount;
+}
+
+bool DynamicBvh::update(int proxy, const Aabb& box)
+{
+    if (m_nodes[proxy].box.contains(box)) return false;
+
+    removeLeaf(proxy);
+    m_nodes[proxy].box = box.expanded(m_fatMargin);
+    insertLeaf(proxy);
+    return true;
+}
+
+void DynamicBvh::clear()
+{
+    m_nodes.clear();
+    m_root = NULL_NODE;
+    m_freeList = NULL_NODE;
+    m_leafCount = 0;
+}
+
+int DynamicBvh::allocateNode()
+{
+    if (m_freeList == NULL_NODE) {
+        m_nodes.emplace_back();
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+
+    const int node = m_freeList;
+    m_freeList = m_nodes[node].parent;
+    m_nodes[node] = Node();
+    return node;
+}
+
+void DynamicBvh::freeNode(int node)
+{
+    m_nodes[node].parent = m_freeList;
+    m_nodes[node].height = -1;
+    m_nodes[node].child1 = m_nodes[node].child2 = NULL_NODE;
+    m_freeList = node;
+}
+
+void DynamicBvh::insertLeaf(int leaf)
+{
+    if (m_root == NULL_NODE) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the sibling with the lowest surface-area cost
+    const Aabb leafBox = m_nodes[leaf].box;
+    int index = m_root;
+    while (!m_nodes[index].isLeaf()) {
+        const Node& current = m_nodes[index];
+        const float area = current.box.surfaceArea();
+        const float combinedArea = Aabb::merge(current.box, leafBox).surfaceArea();
+
+        // Cost of making a new parent here vs. pushing the leaf further down
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto childCost = [&](int child) {
+            const Aabb merged = Aabb::merge(leafBox, m_nodes[child].box);
+            if (m_nodes[child].isLeaf()) {
+                return merged.surfaceArea() + inheritanceCost;
+            }
+            return merged.surfaceArea() - m_nodes[child].box.surfaceArea() + inheritanceCost;
+            };
+
+        const float cost1 = childCost(current.child1);
+        const float cost2 = childCost(current.child2);
+        if (cost < cost1 && cost < cost2) break;
+
+        index = cost1 < cost2 ? current.child1 : current.child2;
+    }
+
+    const int sibling = index;
+    const int oldParent = m_nodes[sibling].parent;
+    const int newParent = allocateNode();
+
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].box = Aabb::merge(leafBox, m_nodes[sibling].box);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE) {
+        m_root = newParent;
+    }
+    else if (m_nodes[oldParent].child1 == sibling) {
+        m_nodes[oldParent].child1 = newParent;
+    }
+    else {
+        m_nodes[oldParent].child2 = newParent;
+    }
+
+    refitAncestors(m_nodes[leaf].parent);
+}
+
+void DynamicBvh::removeLeaf(int leaf)
+{
+    if (leaf == m_root) {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    const int parent = m_nodes[leaf].parent;
+    const int grandParent = m_nodes[parent].parent;
+    const int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent == NULL_NODE) {
+        m_root = sibling;
+        m_nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    // Splice the sibling into the parent's place
+    if (m_nodes[grandParent].child1 == parent) {
+        m_nodes[grandParent].child1 = sibling;
+    }
+    else {
+        m_nodes[grandParent].child2 = sibling;
+    }
+    m_nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refitAncestors(grandParent);
+}
+
+void DynamicBvh::refitAncestors(int node)
+{
+    while (node != NULL_NODE) {
+        node = balance(node);
+
+        Node& n = m_nodes[node];
+        n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+        n.box = Aabb::merge(m_nodes[n.child1].box, m_nodes[n.child2].box);
+
+        node = n.parent;
+    }
+}
+
+int DynamicBvh::balance(int iA)
+{
+    // Single left/right rotation when the children's heights differ by more than one
+    Node* A = &m_nodes[iA];
+    if (A->isLeaf() || A->height < 2) return iA;
+
+    const int iB = A->child1;
+    const int iC = A->child2;
+    Node* B = &m_nodes[iB];
+    Node* C = &m_nodes[iC];
+    const int heightDelta = C->height - B->height;
+
+    auto rotate = [&](int iUp, Node* up, Node* stay) {
+        // `up` (a child of A) becomes A's parent; A keeps `stay` and one child of `up`
+        const int iF = up->child1;
+        const int iG = up->child2;
+        Node* F = &m_nodes[iF];
+        Node* G = &m_nodes[iG];
+
+        up->child1 = iA;
+        up->parent = A->parent;
+        A->parent = iUp;
+
+        if (up->parent == NULL_NODE) {
+            m_root = iUp;
+        }
+        else if (m_nodes[up->parent].child1 == iA) {
+            m_nodes[up->parent].child1 = iUp;
+        }
+        else {
+            m_nodes[up->parent].child2 = iUp;
+        }
+
+        // Keep the taller grandchild under `up`, hand the other to A
+        const bool keepF = F->height > G->height;
+        const int iKeep = keepF ? iF : iG;
+        const int iGive = keepF ? iG : iF;
+        Node* give = &m_nodes[iGive];
+
+        up->child2 = iKeep;
+        if (A->child1 == iUp) {
+            A->child1 = iGive;
+        }
+        else {
+            A->child2 = iGive;
+        }
+        give->parent = iA;
+
+        A->box = Aabb::merge(stay->box, give->box);
+        A->height = 1 + std::max(stay->height, give->height);
+        up->box = Aabb::merge(A->box, m_nodes[iKeep].box);
+        up->height = 1 + std::max(A->height, m_nodes[iKeep].height);
+        return iUp;
+        };
+
+    if (heightDelta > 1) return rotate(iC, C, B);
+    if (heightDelta < -1) return rotate(iB, B, C);
+    return iA;
+}
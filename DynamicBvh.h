@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Bounds.h"
+
+#include <vector>
+
+
+// ===================================================================
+// == DynamicBvh Declaration
+// ===================================================================
+// Incrementally updated bounding volume hierarchy over primitive AABBs.
+// Leaves store a slightly enlarged ("fat") box, so small transform
+// changes only refit when an object leaves its fat box; inserts pick
+// the cheapest sibling by surface area and the tree is kept balanced
+// with AVL-style rotations. The editor walks it for ray picking
+// (RayPicker); the renderer does not issue frustum queries yet.
+class DynamicBvh
+{
+public:
+    static constexpr int NULL_NODE = -1;
+
+    explicit DynamicBvh(float fatMargin = 0.1f);
+
+    // Returns a proxy handle for the new leaf
+    int insert(const Aabb& box, int userData);
+    void remove(int proxy);
+
+    // Refits only when `box` escapes the stored fat box; returns true if the tree changed
+    bool update(int proxy, const Aabb& box);
+
+    void clear();
+
+    int userData(int proxy) const { return m_nodes[proxy].userData; }
+    const Aabb& fatBounds(int proxy) const { return m_nodes[proxy].box; }
+    int leafCount() const { return m_leafCount; }
+    int height() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+
+    // Calls visit(userData) for every leaf whose fat box is inside or intersects `frustum`
+    template<typename Visit>
+    void query(const Frustum& frustum, Visit visit) const;
+
+    // Calls visit(userData) for every leaf whose fat box overlaps `box`
+    template<typename Visit>
+    void query(const Aabb& box, Visit visit) const;
+
+    // Raw node access for traversals with custom tests (e.g. ray picking)
+    struct Node {
+        Aabb box;
+        int parent = NULL_NODE;   // Doubles as the free-list link
+        int child1 = NULL_NODE;
+        int child2 = NULL_NODE;
+        int height = -1;          // 0 = leaf, -1 = free
+        int userData = -1;
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+    int root() const { return m_root; }
+    const Node& node(int index) const { return m_nodes[index]; }
+
+private:
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    void refitAncestors(int node);
+    int balance(int node);
+
+    template<typename Visit>
+    void visitSubtree(int node, Visit& visit) const;
+
+    std::vector<Node> m_nodes;
+    mutable std::vector<int> m_stack;
+    int m_root = NULL_NODE;
+    int m_freeList = NULL_NODE;
+    int m_leafCount = 0;
+    float m_fatMargin;
+};
+
+template<typename Visit>
+void DynamicBvh::visitSubtree(int node, Visit& visit) const
+{
+    // Subtree fully inside the query: no more tests needed
+    const size_t base = m_stack.size();
+    m_stack.push_back(node);
+    while (m_stack.size() > base) {
+        const int current = m_stack.back();
+        m_stack.pop_back();
+
+        const Node& n = m_nodes[current];
+        if (n.isLeaf()) {
+            visit(n.userData);
+        }
+        else {
+            m_stack.push_back(n.child1);
+            m_stack.push_back(n.child2);
+        }
+    }
+}
+
+template<typename Visit>
+void DynamicBvh::query(const Frustum& frustum, Visit visit) const
+{
+    if (m_root == NULL_NODE) return;
+
+    m_stack.clear();
+    m_stack.push_back(m_root);
+    while (!m_stack.empty()) {
+        const int current = m_stack.back();
+        m_stack.pop_back();
+
+        const Node& n = m_nodes[current];
+        const Frustum::Containment containment = frustum.classify(n.box);
+        if (containment == Frustum::Outside) continue;
+
+        if (n.isLeaf()) {
+            visit(n.userData);
+        }
+        else if (containment == Frustum::Inside) {
+            visitSubtree(current, visit);
+        }
+        else {
+            m_stack.push_back(n.child1);
+            m_stack.push_back(n.child2);
+        }
+    }
+}
+
+template<typename Visit>
+void DynamicBvh::query(const Aabb& box, Visit visit) const
+{
+    if (m_root == NULL_NODE) return;
+
+    m_stack.clear();
+    m_stack.push_back(m_root);
+    while (!m_stack.empty()) {
+        const int current = m_stack.back();
+        m_stack.pop_back();
+
+        const Node& n = m_nodes[current];
+        if (n.box.max.x < box.min.x || n.box.min.x > box.max.x ||
+            n.box.max.y < box.min.y || n.box.min.y > box.max.y ||
+            n.box.max.z < box.min.z || n.box.min.z > box.max.z) {
+            continue;
+        }
+
+        if (n.isLeaf()) {
+            visit(n.userData);
+        }
+        else {
+            m_stack.push_back(n.child1);
+            m_stack.push_back(n.child2);
+        }
+    }
+}
@@ -2,137 +2,71 @@
 #include "VulkanWindow.h"
 #include "VulkanRenderer.h"
 #include "VPrimatives.h"
+#include "OutlinerModel.h"
+#include "ViewportOverlay.h"
+#include "CaptureSession.h"
+#include "FrameProfiler.h"
+#include "TraceRecorder.h"
+#include "FrameScheduler.h"
 
 #include <QVulkanInstance>
 #include <QVBoxLayout>
 #include <QTreeWidgetItem>
+#include <QTreeView>
 #include <QDebug>
 #include <QPainter>
 #include <QMouseEvent>
 #include <QFileDialog>
+#include <QFile>
 #include <QStandardPaths>
 #include <QImage>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QThreadPool>
+#include <QThread>
 #include <QColorDialog>
 #include <QTimer>
+#include <QScreen>
 #include <QLabel>        
 #include <QDoubleSpinBox>
 #include <QPushButton> 
-
-// ===================================================================
-// == EyeIconDelegate Implementation
-// ===================================================================
-EyeIconDelegate::EyeIconDelegate(QObject* parent)
-    : QStyledItemDelegate(parent)
-{
-}
-
-// Helper function to create fallback eye icons
-QPixmap EyeIconDelegate::createFallbackEyeIcon(bool visible) const
-{
-    QPixmap pixmap(16, 16);
-    pixmap.fill(Qt::transparent);
-
-    QPainter painter(&pixmap);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    if (visible) {
-        // Draw visible eye (open eye)
-        painter.setPen(QPen(Qt::black, 2));
-        painter.setBrush(Qt::NoBrush);
-
-        // Eye outline
-        painter.drawEllipse(2, 6, 12, 4);
-
-        // Pupil
-        painter.setBrush(Qt::black);
-        painter.drawEllipse(7, 7, 2, 2);
-    }
-    else {
-        // Draw hidden eye (crossed out eye)
-        painter.setPen(QPen(Qt::gray, 2));
-        painter.setBrush(Qt::NoBrush);
-
-        // Eye outline
-        painter.drawEllipse(2, 6, 12, 4);
-
-        // Cross out line
-        painter.setPen(QPen(Qt::red, 2));
-        painter.drawLine(2, 2, 14, 14);
-    }
-
-    return pixmap;
-}
-
-void EyeIconDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
-{
-    // Create a copy of the style options
-    QStyleOptionViewItem newOption = option;
-
-    // COMPLETELY remove all checkbox-related features
-    newOption.features &= ~QStyleOptionViewItem::HasCheckIndicator;
-    newOption.state &= ~QStyle::State_HasFocus;
-    newOption.checkState = Qt::Unchecked;
-
-    // Draw the item background and text normally
-    QStyledItemDelegate::paint(painter, newOption, index);
-
-    // Get visibility from custom role instead of checkState
-    bool isVisible = index.data(Qt::UserRole).toBool();
-
-    QPixmap eyeIcon;
-    if (isVisible) {
-        eyeIcon = QPixmap(":/icons/eye_visible.png");
-        if (eyeIcon.isNull()) {
-            eyeIcon = QPixmap(":/icons/icons/eye_visible.png");
-        }
-        if (eyeIcon.isNull()) {
-            eyeIcon = createFallbackEyeIcon(true);
-        }
-    }
-    else {
-        eyeIcon = QPixmap(":/icons/eye_hidden.png");
-        if (eyeIcon.isNull()) {
-            eyeIcon = QPixmap(":/icons/icons/eye_hidden.png");
-        }
-        if (eyeIcon.isNull()) {
-            eyeIcon = createFallbackEyeIcon(false);
+#include <QMessageBox>
+#include <QInputDialog>
+#include <QApplication>
+#include <QItemSelectionModel>
+#include <cmath>
+
+namespace {
+    // Positions and triangle indices of a generated primitive mesh, in the picker's format
+    template<typename Mesh>
+    int addPickMesh(RayPicker& picker, const Mesh& mesh)
+    {
+        std::vector<glm::vec3> positions;
+        positions.reserve(mesh.vertices.size());
+        for (const auto& vertex : mesh.vertices) {
+            positions.push_back(vertex.pos);
         }
+        const std::vector<uint32_t> indices(mesh.indices.begin(), mesh.indices.end());
+        return picker.addMesh(positions, indices);
     }
 
-    if (eyeIcon.isNull()) {
-        qWarning() << "All eye icon loading attempts failed.";
-        return;
-    }
-
-    // Draw the eye icon on the right side
-    int iconSize = 16;
-    int padding = 5;
-    QRect iconRect(option.rect.right() - iconSize - padding,
-        option.rect.y() + (option.rect.height() - iconSize) / 2,
-        iconSize, iconSize);
-
-    painter->drawPixmap(iconRect, eyeIcon);
-}
-
-bool EyeIconDelegate::editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option, const QModelIndex& index)
-{
-    if (event->type() == QEvent::MouseButtonRelease) {
-        auto mouseEvent = static_cast<QMouseEvent*>(event);
-
-        int iconSize = 16;
-        int padding = 5;
-        QRect iconRect(option.rect.right() - iconSize - padding,
-            option.rect.y() + (option.rect.height() - iconSize) / 2,
-            iconSize, iconSize);
+    // The project's Vulkan window with its renderer wrapped by the frame scheduler, so frames are
+    // counted when QVulkanWindow actually starts one rather than when an update request arrives
+    class ScheduledVulkanWindow : public VulkanWindow
+    {
+    public:
+        void setFrameScheduler(FrameScheduler* scheduler) { m_scheduler = scheduler; }
 
-        if (iconRect.contains(mouseEvent->pos())) {
-            // Toggle using custom role instead of checkState
-            bool currentState = model->data(index, Qt::UserRole).toBool();
-            model->setData(index, !currentState, Qt::UserRole);
-            return true;
+        QVulkanWindowRenderer* createRenderer() override
+        {
+            QVulkanWindowRenderer* renderer = VulkanWindow::createRenderer();
+            return m_scheduler ? m_scheduler->wrapRenderer(renderer) : renderer;
         }
-    }
-    return QStyledItemDelegate::editorEvent(event, model, option, index);
+
+    private:
+        QPointer<FrameScheduler> m_scheduler;
+    };
 }
 
 // ===================================================================
@@ -142,8 +76,17 @@ VulkanWidget::VulkanWidget(QWidget* parent, bool autoInit)
     : QMainWindow(parent), ui(new Ui::VulkanWidget) {
     ui->setupUi(this);
 
-    // Configure the tree widget from the UI file
+    // Configure the outliner view from the UI file. The model is flat and every
+    // row has the same height, which keeps scrolling cheap on huge scenes.
+    m_outlinerModel = new OutlinerModel(this);
+    ui->outlinerTree->setModel(m_outlinerModel);
     ui->outlinerTree->setHeaderHidden(true);
+    ui->outlinerTree->setRootIsDecorated(false);
+    ui->outlinerTree->setUniformRowHeights(true);
+
+    // Transform section logic; the spin boxes are attached in setupPropertiesPanel()
+    m_transformPanel = new TransformPanel(this);
+    connect(m_transformPanel, &TransformPanel::transformEdited, this, &VulkanWidget::onTransformEdited);
 
     if (autoInit) {
         setupVulkanWindow();  //  Now it works
@@ -191,134 +134,243 @@ void VulkanWidget::connectSignals() {
     connect(ui->sphereButton, &QPushButton::clicked, this, &VulkanWidget::onSphereClicked);
     connect(ui->cylinderButton, &QPushButton::clicked, this, &VulkanWidget::onCylinderClicked);
     connect(ui->pyramidButton, &QPushButton::clicked, this, &VulkanWidget::onPyramidClicked);
+    connect(ui->actionSpawn_Primitives, &QAction::triggered, this, &VulkanWidget::onSpawnPrimitivesTriggered);
 
     // Clear button to clear all primitives
     connect(ui->clearButton, &QPushButton::clicked, this, &VulkanWidget::onClearClicked);
 
-    // Connect the tree widget's signal to its slot
-    connect(ui->outlinerTree, &QTreeWidget::itemChanged, this, &VulkanWidget::on_outlinerTree_itemChanged);
+    // Forward eye-icon toggles from the outliner model to the renderer
+    connect(m_outlinerModel, &OutlinerModel::visibilityChanged, this, &VulkanWidget::onOutlinerVisibilityChanged);
+    connect(m_outlinerModel, &OutlinerModel::visibilityRangeChanged, this, &VulkanWidget::onOutlinerVisibilityRangeChanged);
 
     // Toggle visibility for Grid
     connect(ui->toggleGridButton, &QPushButton::clicked, this, &VulkanWidget::onToggleGridClicked);
 
     // background color button
     connect(ui->actionChange_Grid_Background, &QAction::triggered, this, &VulkanWidget::onBackgroundColorClicked);
-}
-
-void VulkanWidget::onCubeClicked() {
-    if (!m_vulkanWindow || !m_vulkanWindow->getRenderer()) return;
 
-    auto primitive = VPrimatives::createCube();
-    int id = m_vulkanWindow->getRenderer()->addPrimitive(primitive, "Cube");
+    // Image-sequence recording
+    connect(ui->actionRecord_Image_Sequence, &QAction::toggled, this, &VulkanWidget::onRecordImageSequenceToggled);
 
-    auto* item = new QTreeWidgetItem(ui->outlinerTree);
-    item->setText(0, "Cube");
+    // Frame timing panel in the status bar
+    connect(ui->actionShow_Frame_Stats, &QAction::toggled, this, &VulkanWidget::onFrameStatsToggled);
+    connect(ui->actionRender_On_Demand, &QAction::toggled, this, &VulkanWidget::onRenderOnDemandToggled);
 
-    // Remove ALL checkable flags
-    item->setFlags(item->flags() & ~Qt::ItemIsUserCheckable);
+    // Chrome/Perfetto trace capture
+    connect(ui->actionRecord_Trace, &QAction::toggled, this, &VulkanWidget::onRecordTraceToggled);
 
-    // Use custom data role instead of checkState (true = visible)
-    item->setData(0, Qt::UserRole, true);
+    // Session record / replay
+    connect(ui->actionRecord_Session, &QAction::toggled, this, &VulkanWidget::onRecordSessionToggled);
+    connect(ui->actionReplay_Session, &QAction::triggered, this, &VulkanWidget::onReplaySessionTriggered);
+    connect(this, &VulkanWidget::transformValuesChanged, this, [this](TransformType type, const glm::vec3& values) {
+        // Emitted for the selected row only; the row makes replay independent of the selection at that time
+        recordSessionCommand(SessionCommand::SetTransform, type, m_selectedRow, values);
+        });
 
-    // REMOVE this line completely:
-    // item->setCheckState(0, Qt::Checked);
+    // Selecting a row (from the outliner or a viewport pick) fills the Transform section
+    connect(ui->outlinerTree->selectionModel(), &QItemSelectionModel::currentChanged, this, &VulkanWidget::onOutlinerCurrentChanged);
+}
 
-    m_primitiveItems[item] = id;
+void VulkanWidget::onCubeClicked() {
+    spawnPrimitives(CubePrimitive, 1);
 }
 
 void VulkanWidget::onSphereClicked() {
-    if (!m_vulkanWindow || !m_vulkanWindow->getRenderer()) return;
-
-    auto primitive = VPrimatives::createSphere();
-    int id = m_vulkanWindow->getRenderer()->addPrimitive(primitive, "Sphere");
+    spawnPrimitives(SpherePrimitive, 1);
+}
 
-    auto* item = new QTreeWidgetItem(ui->outlinerTree);
-    item->setText(0, "Sphere");
+void VulkanWidget::onCylinderClicked() {
+    spawnPrimitives(CylinderPrimitive, 1);
+}
 
-    // Remove ALL checkable flags
-    item->setFlags(item->flags() & ~Qt::ItemIsUserCheckable);
+void VulkanWidget::onPyramidClicked() {
+    spawnPrimitives(PyramidPrimitive, 1);
+}
 
-    // Use custom data role instead of checkState
-    item->setData(0, Qt::UserRole, true);
+void VulkanWidget::onSpawnPrimitivesTriggered() {
+    // Bulk spawn for stress scenes: one outliner insert for the whole batch
+    const QStringList kinds = { "Cube", "Sphere", "Cylinder", "Pyramid" };
+    bool ok = false;
+    const QString kindName = QInputDialog::getItem(this, "Spawn Primitives", "Primitive:", kinds, 0, false, &ok);
+    if (!ok) return;
 
-    // REMOVE this line:
-    // item->setCheckState(0, Qt::Checked);
+    const int count = QInputDialog::getInt(this, "Spawn Primitives", "Count:", 1000, 1, 1000000, 100, &ok);
+    if (!ok) return;
 
-    m_primitiveItems[item] = id;
+    spawnPrimitives(PrimitiveKind(kinds.indexOf(kindName)), count);
 }
 
-void VulkanWidget::onCylinderClicked() {
-    if (!m_vulkanWindow || !m_vulkanWindow->getRenderer()) return;
+void VulkanWidget::spawnPrimitives(PrimitiveKind kind, int count) {
+    PROFILE_SCOPE("editor.spawnPrimitives");
+    TRACE_SCOPE("scene", "spawnPrimitives");
+    if (!m_vulkanWindow || !m_vulkanWindow->getRenderer() || count <= 0) return;
+    recordSessionCommand(SessionCommand::SpawnPrimitives, kind, count);
 
-    auto primitive = VPrimatives::createCylinder();
-    int id = m_vulkanWindow->getRenderer()->addPrimitive(primitive, "Cylinder");
+    auto generate = [kind]() {
+        switch (kind) {
+        case SpherePrimitive:   return VPrimatives::createSphere();
+        case CylinderPrimitive: return VPrimatives::createCylinder();
+        case PyramidPrimitive:  return VPrimatives::createPyramid();
+        case CubePrimitive:
+        default:                return VPrimatives::createCube();
+        }
+        };
 
-    auto* item = new QTreeWidgetItem(ui->outlinerTree);
-    item->setText(0, "Cylinder");
+    const char* name = "Cube";
+    switch (kind) {
+    case SpherePrimitive:   name = "Sphere"; break;
+    case CylinderPrimitive: name = "Cylinder"; break;
+    case PyramidPrimitive:  name = "Pyramid"; break;
+    case CubePrimitive:
+    default:                break;
+    }
 
-    // Remove ALL checkable flags
-    item->setFlags(item->flags() & ~Qt::ItemIsUserCheckable);
+    // Every primitive of a kind shares one cached mesh; it is only generated on the first request
+    PrimitiveMeshCache::Handle mesh = m_meshCache.acquire(kind, generate);
 
-    // Use custom data role instead of checkState
-    item->setData(0, Qt::UserRole, true);
+    // The picker keeps its own packed copy of each shape's triangles
+    auto pickMesh = m_pickMeshes.find(kind);
+    if (pickMesh == m_pickMeshes.end()) {
+        pickMesh = m_pickMeshes.insert(kind, addPickMesh(m_picker, *mesh));
+    }
 
-    // REMOVE this line:
-    // item->setCheckState(0, Qt::Checked);
+    std::vector<PrimitiveHandle> handles;
+    handles.reserve(count);
+    m_primitiveMeshes.reserve(m_primitiveMeshes.size() + count);
+    for (int i = 0; i < count; ++i) {
+        PrimitiveRecord record;
+        record.rendererId = m_vulkanWindow->getRenderer()->addPrimitive(*mesh, name);
+        record.row = m_transforms.add();
+        m_primitiveMeshes.push_back(mesh);
+        m_picker.addObject(pickMesh.value(), glm::mat4(1.0f), record.rendererId);
+        handles.push_back(m_primitives.insert(record));
+    }
 
-    m_primitiveItems[item] = id;
+    m_outlinerModel->appendPrimitives(handles, QString::fromLatin1(name));
+    markViewportDirty(FrameScheduler::SceneSource);
 }
 
-void VulkanWidget::onPyramidClicked() {
+void VulkanWidget::onClearClicked() {
+    PROFILE_SCOPE("editor.clear");
+    TRACE_SCOPE("scene", "clearPrimitives");
     if (!m_vulkanWindow || !m_vulkanWindow->getRenderer()) return;
+    recordSessionCommand(SessionCommand::ClearScene);
+    m_vulkanWindow->getRenderer()->clearPrimitives();
 
-    auto primitive = VPrimatives::createPyramid();
-    int id = m_vulkanWindow->getRenderer()->addPrimitive(primitive, "Pyramid");
+    // clearPrimitives() has released the scene's GPU buffers synchronously; what is left are the
+    // outliner names and mesh handles. Both are moved out in O(1) and freed on a worker thread
+    struct ClearedScene {
+        QVector<QString> names;
+        std::vector<PrimitiveMeshCache::Handle> meshes;
+    };
+    auto cleared = std::make_shared<ClearedScene>();
+    cleared->names = m_outlinerModel->takeAll();
+    cleared->meshes.swap(m_primitiveMeshes);
+
+    QPointer<VulkanWidget> self(this);
+    QThreadPool::globalInstance()->start([self, cleared]() {
+        TRACE_SCOPE("scene", "releaseCleared");
+        cleared->names.clear();
+        cleared->meshes.clear();
+
+        // Unused shapes drop out of the cache once their last handle is gone
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [self]() {
+            if (self) self->m_meshCache.purge();
+            }, Qt::QueuedConnection);
+        });
 
-    auto* item = new QTreeWidgetItem(ui->outlinerTree);
-    item->setText(0, "Pyramid");
+    // Outstanding handles (queued edits, replayed commands) become stale; the rest is plain data
+    m_primitives.clear();
+    m_transformPanel->discardEdits();
+    m_transformPanel->setPrimitive(PrimitiveHandle());
+    m_transforms.clear();
+    m_picker.clearObjects();
+    m_selectedRow = -1;
+    markViewportDirty(FrameScheduler::SceneSource);
+}
 
-    // Remove ALL checkable flags
-    item->setFlags(item->flags() & ~Qt::ItemIsUserCheckable);
 
-    // Use custom data role instead of checkState
-    item->setData(0, Qt::UserRole, true);
+void VulkanWidget::onOutlinerVisibilityChanged(int row, PrimitiveHandle primitive, bool visible) {
+    TRACE_SCOPE("scene", "visibilityChanged");
+    recordSessionCommand(SessionCommand::SetVisibility, row, visible);
 
+    const PrimitiveRecord* record = m_primitives.get(primitive);
+    if (!record) return;
 
-    m_primitiveItems[item] = id;
+    m_picker.setPickable(record->row, visible);
+    if (m_vulkanWindow && m_vulkanWindow->getRenderer()) {
+        m_vulkanWindow->getRenderer()->setPrimitiveVisibility(record->rendererId, visible);
+        markViewportDirty(FrameScheduler::SceneSource);
+    }
 }
 
-void VulkanWidget::onClearClicked() {
+void VulkanWidget::onOutlinerVisibilityRangeChanged(const QVector<PrimitiveHandle>& primitives, bool visible) {
+    PROFILE_SCOPE("editor.visibilityRange");
+    TRACE_SCOPE("scene", "visibilityRange");
     if (!m_vulkanWindow || !m_vulkanWindow->getRenderer()) return;
-    m_vulkanWindow->getRenderer()->clearPrimitives();
-    ui->outlinerTree->clear();
-    m_primitiveItems.clear();
+
+    auto* renderer = m_vulkanWindow->getRenderer();
+    for (const PrimitiveHandle& primitive : primitives) {
+        if (const PrimitiveRecord* record = m_primitives.get(primitive)) {
+            renderer->setPrimitiveVisibility(record->rendererId, visible);
+            m_picker.setPickable(record->row, visible);
+        }
+    }
+    if (!primitives.isEmpty()) {
+        markViewportDirty(FrameScheduler::SceneSource);
+    }
 }
 
+void VulkanWidget::onOutlinerCurrentChanged(const QModelIndex& current) {
+    // Edits still waiting for the frame belong to the previous selection
+    flushTransformEdits();
 
-void VulkanWidget::on_outlinerTree_itemChanged(QTreeWidgetItem* item, int column) {
-    if (column == 0 && m_primitiveItems.contains(item)) {
-        int primitiveId = m_primitiveItems[item];
-        // Get visibility from custom role instead of checkState
-        bool isVisible = item->data(0, Qt::UserRole).toBool();
+    m_selectedRow = current.isValid() ? current.row() : -1;
+    m_transformPanel->setPrimitive(selectedPrimitive());
+    if (m_selectedRow < 0 || m_selectedRow >= m_transforms.size()) return;
 
-        if (m_vulkanWindow && m_vulkanWindow->getRenderer()) {
-            m_vulkanWindow->getRenderer()->setPrimitiveVisibility(primitiveId, isVisible);
-        }
+    updateTransformPanel(m_transforms.position(m_selectedRow), m_transforms.rotation(m_selectedRow), m_transforms.scale(m_selectedRow));
+}
+
+void VulkanWidget::setViewportCamera(const glm::mat4& view, const glm::mat4& projection) {
+    m_viewMatrix = view;
+    m_projectionMatrix = projection;
+    m_hasViewportCamera = true;
+}
+
+int VulkanWidget::pickPrimitive(const QPointF& viewportPosition) {
+    PROFILE_SCOPE("editor.pick");
+    TRACE_SCOPE("scene", "pickPrimitive");
+    if (!m_vulkanWindow || !m_hasViewportCamera || m_vulkanWindow->width() <= 0 || m_vulkanWindow->height() <= 0) return -1;
+
+    // Vulkan NDC: +Y points down, so window coordinates map without a flip
+    const float ndcX = float(viewportPosition.x() / m_vulkanWindow->width()) * 2.0f - 1.0f;
+    const float ndcY = float(viewportPosition.y() / m_vulkanWindow->height()) * 2.0f - 1.0f;
+    const Ray ray = Ray::fromNdc(ndcX, ndcY, glm::inverse(m_projectionMatrix * m_viewMatrix));
+
+    const RayPicker::Hit hit = m_picker.pick(ray);
+    if (!hit.isValid()) {
+        ui->outlinerTree->clearSelection();
+        ui->outlinerTree->setCurrentIndex(QModelIndex());
+        return -1;
     }
+
+    // Picker objects are numbered like outliner rows; the current-changed handler fills the panel
+    const QModelIndex index = m_outlinerModel->index(hit.object, 0);
+    ui->outlinerTree->setCurrentIndex(index);
+    ui->outlinerTree->scrollTo(index);
+    return hit.object;
 }
 
 void VulkanWidget::onShowAllClicked() {
-    for (int i = 0; i < ui->outlinerTree->topLevelItemCount(); ++i) {
-        // Use custom role instead of checkState
-        ui->outlinerTree->topLevelItem(i)->setData(0, Qt::UserRole, true);
-    }
+    // One model update and one renderer pass for the whole outliner
+    recordSessionCommand(SessionCommand::SetAllVisible, 0, true);
+    m_outlinerModel->setAllVisible(true);
 }
 
 void VulkanWidget::onHideAllClicked() {
-    for (int i = 0; i < ui->outlinerTree->topLevelItemCount(); ++i) {
-        // Use custom role instead of checkState
-        ui->outlinerTree->topLevelItem(i)->setData(0, Qt::UserRole, false);
-    }
+    recordSessionCommand(SessionCommand::SetAllVisible, 0, false);
+    m_outlinerModel->setAllVisible(false);
 }
 
 void VulkanWidget::onScreenshotClicked() {
@@ -327,15 +379,258 @@ void VulkanWidget::onScreenshotClicked() {
     QString filePath = QFileDialog::getSaveFileName(this, "Save Screenshot",
         defaultPath + "/screenshot.png", "PNG Images (*.png)");
     if (filePath.isEmpty()) return;
-    QImage image = m_vulkanWindow->grab();
-    if (!image.save(filePath)) {
-        qWarning() << "Failed to save screenshot";
+
+    QElapsedTimer latency;
+    latency.start();
+    QImage image;
+    {
+        TRACE_SCOPE("render", "screenshotReadback");
+        image = m_vulkanWindow->grab();
+    }
+    const double guiBlockMs = latency.nsecsElapsed() / 1e6;
+
+    // Encode off the GUI thread; the result is reported back through screenshotSaved()
+    QPointer<VulkanWidget> self(this);
+    QThreadPool::globalInstance()->start([self, image, filePath, latency, guiBlockMs]() {
+        TRACE_SCOPE("io", "screenshotEncode");
+        QElapsedTimer encodeTimer;
+        encodeTimer.start();
+        const bool success = image.save(filePath, "PNG");
+        const double encodeMs = encodeTimer.nsecsElapsed() / 1e6;
+
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [self, filePath, success, latency, guiBlockMs, encodeMs]() {
+            if (!self) return;
+            if (!success) {
+                qWarning() << "Failed to save screenshot";
+            }
+
+            self->m_lastScreenshotTiming.guiBlockMs = guiBlockMs;
+            self->m_lastScreenshotTiming.encodeMs = encodeMs;
+            self->m_lastScreenshotTiming.latencyMs = latency.nsecsElapsed() / 1e6;
+            emit self->screenshotSaved(filePath, success);
+            }, Qt::QueuedConnection);
+        });
+}
+
+void VulkanWidget::onRecordImageSequenceToggled(bool checked) {
+    if (!checked) {
+        const CaptureSession::Stats stats = stopImageSequence();
+        QString report = QString("%1 frames written").arg(stats.written);
+        if (stats.dropped > 0) {
+            report += QString(", %1 dropped because the encoders fell behind").arg(stats.dropped);
+        }
+        if (stats.failed > 0) {
+            report += QString(", %1 failed to write").arg(stats.failed);
+        }
+        QMessageBox::information(this, "Image Sequence", report + ".");
+        return;
+    }
+
+    QString defaultPath = QStandardPaths::writableLocation(QStandardPaths::PicturesLocation);
+    QString directory = QFileDialog::getExistingDirectory(this, "Record Image Sequence To", defaultPath);
+    if (directory.isEmpty() || !startImageSequence(directory)) {
+        QSignalBlocker blocker(ui->actionRecord_Image_Sequence);
+        ui->actionRecord_Image_Sequence->setChecked(false);
+    }
+}
+
+bool VulkanWidget::startImageSequence(const QString& directory, int framesPerSecond) {
+    if (!m_vulkanWindow || m_captureSession || framesPerSecond <= 0) return false;
+
+    CaptureSession::Settings settings;
+    settings.directory = directory;
+    settings.encoderThreads = qBound(1, QThread::idealThreadCount() - 1, 4);
+    m_captureSession = new CaptureSession(settings, this);
+
+    if (!m_captureTimer) {
+        m_captureTimer = new QTimer(this);
+        m_captureTimer->setTimerType(Qt::PreciseTimer);
+        connect(m_captureTimer, &QTimer::timeout, this, &VulkanWidget::onCaptureTick);
+    }
+    m_captureTimer->start(qMax(1, 1000 / framesPerSecond));
+    return true;
+}
+
+CaptureSession::Stats VulkanWidget::stopImageSequence() {
+    if (m_captureTimer) {
+        m_captureTimer->stop();
+    }
+    if (!m_captureSession) return CaptureSession::Stats();
+
+    // Drain the encoders so every accepted frame is on disk before the counts are read
+    m_captureSession->finish();
+    const CaptureSession::Stats stats = m_captureSession->stats();
+
+    delete m_captureSession;
+    m_captureSession = nullptr;
+    return stats;
+}
+
+void VulkanWidget::onCaptureTick() {
+    PROFILE_SCOPE("editor.captureFrame");
+    TRACE_SCOPE("capture", "captureFrame");
+    if (!m_captureSession || !m_vulkanWindow) return;
+    // grab() returns a fresh image that submitFrame() copies into a ring slot. Reading back
+    // straight into the slot needs a readback entry point on the renderer.
+    m_captureSession->submitFrame(m_vulkanWindow->grab());
+}
+
+void VulkanWidget::onFrameStatsToggled(bool checked) {
+    FrameProfiler::instance().setEnabled(checked);
+
+    if (!checked) {
+        if (m_frameStatsTimer) {
+            m_frameStatsTimer->stop();
+        }
+        ui->statusbar->hide();
+        return;
+    }
+
+    if (!m_frameStatsLabel) {
+        m_frameStatsLabel = new QLabel(this);
+        ui->statusbar->addWidget(m_frameStatsLabel, 1);
+        // The base style collapses the status bar; give it a real height while stats are shown
+        ui->statusbar->setStyleSheet("QStatusBar { min-height: 20px; max-height: 20px; padding: 0px 6px; }");
+    }
+    if (!m_frameStatsTimer) {
+        m_frameStatsTimer = new QTimer(this);
+        m_frameStatsTimer->setInterval(500);
+        connect(m_frameStatsTimer, &QTimer::timeout, this, &VulkanWidget::refreshFrameStats);
+    }
+
+    m_frameStatsLabel->setText("Collecting frame stats...");
+    ui->statusbar->show();
+    m_frameStatsTimer->start();
+}
+
+void VulkanWidget::refreshFrameStats() {
+    const QVector<FrameProfiler::StageStats> stages = FrameProfiler::instance().snapshot();
+
+    QStringList parts;
+    if (m_frameScheduler) {
+        parts << QString("rendered %1  skipped %2")
+            .arg(m_frameScheduler->renderedFrames())
+            .arg(m_frameScheduler->skippedFrames());
+    }
+    if (parts.isEmpty() && stages.isEmpty()) return;
+
+    for (const FrameProfiler::StageStats& stage : stages) {
+        parts << QString("%1  p50 %2  p95 %3  p99 %4 ms")
+            .arg(stage.name)
+            .arg(stage.p50, 0, 'f', 2)
+            .arg(stage.p95, 0, 'f', 2)
+            .arg(stage.p99, 0, 'f', 2);
+    }
+    m_frameStatsLabel->setText(parts.join("   |   "));
+}
+
+void VulkanWidget::onRecordTraceToggled(bool checked) {
+    if (checked) {
+        TraceRecorder::instance().start();
+        return;
+    }
+
+    TraceRecorder::instance().stop();
+    QString defaultPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    QString filePath = QFileDialog::getSaveFileName(this, "Save Performance Trace",
+        defaultPath + "/fleura_trace.json", "Chrome Trace (*.json)");
+    if (filePath.isEmpty()) return;
+
+    if (!TraceRecorder::instance().writeChromeTrace(filePath)) {
+        qWarning() << "Failed to write trace to" << filePath;
+    }
+}
+
+void VulkanWidget::onRecordSessionToggled(bool checked) {
+    if (!checked) {
+        m_sessionRecorder.stop();
+        return;
+    }
+
+    QString defaultPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    QString filePath = QFileDialog::getSaveFileName(this, "Record Session",
+        defaultPath + "/session.flsession", "Fleura Session (*.flsession)");
+    if (filePath.isEmpty() || !m_sessionRecorder.start(filePath)) {
+        QSignalBlocker blocker(ui->actionRecord_Session);
+        ui->actionRecord_Session->setChecked(false);
+    }
+}
+
+void VulkanWidget::onReplaySessionTriggered() {
+    if (m_sessionReplayer && m_sessionReplayer->isReplaying()) return;
+
+    QString defaultPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    QString filePath = QFileDialog::getOpenFileName(this, "Replay Session", defaultPath, "Fleura Session (*.flsession)");
+    if (filePath.isEmpty()) return;
+
+    if (!m_sessionReplayer) {
+        m_sessionReplayer = new SessionReplayer(this);
+        connect(m_sessionReplayer, &SessionReplayer::finished, this, [this]() {
+            QMessageBox::information(this, "Session Replay", m_sessionReplayer->report());
+            });
+    }
+    if (!m_sessionReplayer->load(filePath)) {
+        qWarning() << "Failed to load session log" << filePath;
+        return;
+    }
+
+    const bool originalPace = QMessageBox::question(this, "Session Replay",
+        "Replay at the original pace?\n(No replays as fast as possible.)") == QMessageBox::Yes;
+    m_sessionReplayer->replay([this](const SessionCommand& command) { applySessionCommand(command); }, originalPace);
+}
+
+void VulkanWidget::recordSessionCommand(SessionCommand::Type type, qint32 a, qint32 b, const glm::vec3& vector) {
+    // Commands issued by a replay are not recorded again
+    if (!m_sessionRecorder.isRecording() || (m_sessionReplayer && m_sessionReplayer->isReplaying())) return;
+
+    SessionCommand command;
+    command.type = type;
+    command.a = a;
+    command.b = b;
+    command.vector = vector;
+    m_sessionRecorder.record(command);
+}
+
+void VulkanWidget::applySessionCommand(const SessionCommand& command) {
+    switch (command.type) {
+    case SessionCommand::SpawnPrimitives:
+        spawnPrimitives(PrimitiveKind(command.a), command.b);
+        break;
+    case SessionCommand::ClearScene:
+        onClearClicked();
+        break;
+    case SessionCommand::SetTransform:
+        // Select the recorded row first, so the panel and the renderer's selection match the recording
+        if (command.b >= 0 && command.b < m_outlinerModel->primitiveCount()) {
+            ui->outlinerTree->setCurrentIndex(m_outlinerModel->index(command.b, 0));
+        }
+        else {
+            ui->outlinerTree->setCurrentIndex(QModelIndex());
+        }
+        m_transformPanel->queueEdit(selectedPrimitive(), TransformPanel::Channel(command.a), command.vector);
+        flushTransformEdits();
+        break;
+    case SessionCommand::KeyState:
+        setCameraKey(command.a, command.b != 0);
+        break;
+    case SessionCommand::SetVisibility:
+        // Rows are stable across runs, renderer IDs are not
+        if (command.a >= 0 && command.a < m_outlinerModel->primitiveCount()) {
+            m_outlinerModel->setData(m_outlinerModel->index(command.a, 0), command.b != 0, Qt::UserRole);
+        }
+        break;
+    case SessionCommand::SetAllVisible:
+        m_outlinerModel->setAllVisible(command.b != 0);
+        break;
+    default:
+        break;
     }
 }
 
 void VulkanWidget::onToggleGridClicked() {
     if (m_vulkanWindow && m_vulkanWindow->getRenderer()) {
         m_vulkanWindow->getRenderer()->toggleGrid();
+        markViewportDirty(FrameScheduler::AppearanceSource);
     }
 }
 
@@ -344,6 +639,7 @@ void VulkanWidget::onBackgroundColorClicked() {
     if (color.isValid()) {
         if (m_vulkanWindow && m_vulkanWindow->getRenderer()) {
             m_vulkanWindow->getRenderer()->setBackgroundColor(glm::vec4(color.redF(), color.greenF(), color.blueF(), color.alphaF()));
+            markViewportDirty(FrameScheduler::AppearanceSource);
         }
     }
 }
@@ -355,9 +651,16 @@ void VulkanWidget::setupVulkanWindow() {
     m_isVulkanInitialized = true;
 
     // STEP 1: Create Vulkan window
-    m_vulkanWindow = new VulkanWindow();
+    auto* vulkanWindow = new ScheduledVulkanWindow();
+    m_vulkanWindow = vulkanWindow;
     m_vulkanWindow->setVulkanInstance(createVulkanInstance());
 
+    // Update requests only reach the renderer while something in the viewport is dirty; the
+    // renderer is created on first expose, after this, so every frame it starts is counted
+    m_frameScheduler = new FrameScheduler(m_vulkanWindow, this);
+    m_frameScheduler->setOnDemand(ui->actionRender_On_Demand->isChecked());
+    vulkanWindow->setFrameScheduler(m_frameScheduler);
+
     // STEP 2: Create Qt wrapper
     QWidget* vulkanContainerWidget = QWidget::createWindowContainer(m_vulkanWindow, ui->vulkanContainer);
     vulkanContainerWidget->setFocusPolicy(Qt::StrongFocus);
@@ -380,8 +683,14 @@ void VulkanWidget::setupVulkanWindow() {
     // STEP 5: Initialize overlay system with proper timing
     initializeOverlaySystem();
 
-    // STEP 6: Install event filter to handle focus changes
+    // STEP 6: Install event filters to handle focus changes and splitter resizes
     this->installEventFilter(this);
+    ui->vulkanContainer->installEventFilter(this);
+    if (m_overlayMode == InFrameOverlay && m_viewportOverlay) {
+        // The mode was chosen before the viewport existed
+        m_vulkanWindow->installEventFilter(m_viewportOverlay);
+        m_viewportOverlay->setViewportSize(m_vulkanWindow->size());
+    }
     connect(m_vulkanWindow, &QWidget::destroyed, this, [this]() {
         if (ui->overlayWidget) {
             ui->overlayWidget->hide();
@@ -413,16 +722,10 @@ void VulkanWidget::setupOverlayWidget() {
     // Initialize button array and setup
     initializeButtonArray();
 
-    // Position overlay and buttons immediately
-    QTimer::singleShot(50, this, [this]() {
-        updateOverlayGeometry();
-        // Force a second update to ensure proper positioning
-        QTimer::singleShot(100, this, [this]() {
-            updateOverlayGeometry();
-            });
-        });
-
     m_overlayInitialized = true;
+
+    // Position overlay and buttons on the next frame tick
+    scheduleOverlayUpdate();
 }
 
 void VulkanWidget::setupOverlayProperties(QWidget* overlay) {
@@ -467,21 +770,32 @@ void VulkanWidget::setupOverlayProperties(QWidget* overlay) {
 }
 
 void VulkanWidget::updateOverlayGeometry() {
+    TRACE_SCOPE("ui", "overlayRelayout");
     if (!m_overlayInitialized || !ui->overlayWidget) return;
 
+    // The in-frame overlay follows the Vulkan window on its own
+    if (m_overlayMode == InFrameOverlay) {
+        ui->overlayWidget->hide();
+        return;
+    }
+
     // Get render area dimensions
     const QSize renderSize = ui->vulkanContainer->size();
     const QPoint topLeft = ui->vulkanContainer->mapToGlobal(QPoint(0, 0));
-    ui->vulkanContainer->installEventFilter(this);
+    const QRect overlayRect(topLeft, renderSize);
 
     // Only show overlay if the main window is active and visible
     if (this->isActiveWindow() && this->isVisible() && !this->isMinimized() &&
         m_vulkanWindow && m_vulkanWindow->isVisible()) {
-        // Update overlay geometry
-        ui->overlayWidget->setGeometry(QRect(topLeft, renderSize));
+        // Only touch the window system when the geometry actually moved
+        if (overlayRect != m_lastOverlayRect || !ui->overlayWidget->isVisible()) {
+            ui->overlayWidget->setGeometry(overlayRect);
 
-        // Position buttons using cached array
-        positionButtons(renderSize);
+            // Position buttons using cached array
+            positionButtons(renderSize);
+            m_lastOverlayRect = overlayRect;
+            ++m_overlayRelayoutCount;
+        }
 
         // Show the overlay
         ui->overlayWidget->show();
@@ -493,6 +807,144 @@ void VulkanWidget::updateOverlayGeometry() {
     }
 }
 
+void VulkanWidget::scheduleOverlayUpdate() {
+    if (!m_overlayInitialized || m_overlayMode == InFrameOverlay) return;
+
+    // Coalesce every request that arrives within one display frame into a single relayout
+    m_overlayGeometryDirty = true;
+    if (!m_overlayGeometryTimer) {
+        m_overlayGeometryTimer = new QTimer(this);
+        m_overlayGeometryTimer->setSingleShot(true);
+        m_overlayGeometryTimer->setTimerType(Qt::PreciseTimer);
+        connect(m_overlayGeometryTimer, &QTimer::timeout, this, [this]() {
+            if (!m_overlayGeometryDirty) return;
+            m_overlayGeometryDirty = false;
+            updateOverlayGeometry();
+            });
+    }
+    if (m_overlayGeometryTimer->isActive()) return;
+
+    m_overlayGeometryTimer->start(frameIntervalMs());
+}
+
+int VulkanWidget::frameIntervalMs() const {
+    const qreal refreshRate = screen() ? screen()->refreshRate() : 60.0;
+    return qMax(1, qRound(1000.0 / (refreshRate > 0.0 ? refreshRate : 60.0)));
+}
+
+PrimitiveHandle VulkanWidget::selectedPrimitive() const {
+    if (m_selectedRow < 0 || m_selectedRow >= m_outlinerModel->primitiveCount()) return PrimitiveHandle();
+    return m_outlinerModel->primitiveHandle(m_selectedRow);
+}
+
+void VulkanWidget::flushTransformEdits() {
+    m_transformPanel->flush();
+}
+
+void VulkanWidget::onTransformEdited(PrimitiveHandle primitive, TransformPanel::Channel channel, const glm::vec3& values) {
+    // A null handle means nothing was selected; a stale one means the primitive is gone
+    const PrimitiveRecord* record = m_primitives.get(primitive);
+    if (!record && !primitive.isNull()) return;
+
+    const int row = record ? record->row : -1;
+    if (record) {
+        switch (channel) {
+        case TransformPanel::Translate: m_transforms.setPosition(row, values); break;
+        case TransformPanel::Rotate:    m_transforms.setRotation(row, values); break;
+        case TransformPanel::Scale:     m_transforms.setScale(row, values); break;
+        default: break;
+        }
+        m_picker.setTransform(row, m_transforms.worldMatrix(row));
+    }
+
+    // The renderer applies transformValuesChanged to the current selection
+    if (row == m_selectedRow) {
+        ++m_transformUpdatesEmitted;
+        emit transformValuesChanged(TransformType(channel), values);
+    }
+    markViewportDirty(FrameScheduler::SceneSource);
+}
+
+void VulkanWidget::markViewportDirty(FrameScheduler::DirtySources sources) {
+    if (m_frameScheduler) {
+        m_frameScheduler->markDirty(sources);
+    }
+}
+
+void VulkanWidget::setCameraKey(int key, bool pressed) {
+    if (!m_vulkanWindow || !m_vulkanWindow->getRenderer()) return;
+    m_vulkanWindow->getRenderer()->setKeyPressed(key, pressed);
+
+    // The camera keeps moving between key events, so render every frame while any key is down
+    if (pressed) {
+        m_heldCameraKeys.insert(key);
+    }
+    else {
+        m_heldCameraKeys.remove(key);
+    }
+    if (m_frameScheduler) {
+        m_frameScheduler->setHeld(FrameScheduler::CameraSource, !m_heldCameraKeys.isEmpty());
+    }
+}
+
+void VulkanWidget::onRenderOnDemandToggled(bool checked) {
+    if (m_frameScheduler) {
+        m_frameScheduler->setOnDemand(checked);
+    }
+}
+
+void VulkanWidget::setOverlayMode(OverlayMode mode) {
+    if (mode == m_overlayMode) return;
+    m_overlayMode = mode;
+
+    if (mode == InFrameOverlay) {
+        setupViewportOverlay();
+        if (m_vulkanWindow && m_viewportOverlay) {
+            m_vulkanWindow->installEventFilter(m_viewportOverlay);
+            m_viewportOverlay->setViewportSize(m_vulkanWindow->size());
+            markViewportDirty(FrameScheduler::OverlaySource);
+        }
+        if (ui->overlayWidget) {
+            ui->overlayWidget->hide();
+        }
+    }
+    else {
+        if (m_vulkanWindow && m_viewportOverlay) {
+            m_vulkanWindow->removeEventFilter(m_viewportOverlay);
+            markViewportDirty(FrameScheduler::OverlaySource);
+        }
+        m_lastOverlayRect = QRect();
+        scheduleOverlayUpdate();
+    }
+}
+
+void VulkanWidget::setupViewportOverlay() {
+    if (m_viewportOverlay) return;
+
+    // Same controls, order and actions as the widget overlay
+    m_viewportOverlay = new ViewportOverlay(this);
+    m_viewportOverlay->addButton("Screenshot");
+    m_viewportOverlay->addButton("Show All");
+    m_viewportOverlay->addButton("Hide All");
+    m_viewportOverlay->addButton("Toggle Grid");
+
+    connect(m_viewportOverlay, &ViewportOverlay::buttonClicked, this, &VulkanWidget::onOverlayButtonClicked);
+    connect(m_viewportOverlay, &ViewportOverlay::changed, this, [this]() {
+        // The renderer picks up the new overlay image on the next frame
+        markViewportDirty(FrameScheduler::OverlaySource);
+        });
+}
+
+void VulkanWidget::onOverlayButtonClicked(int index) {
+    switch (index) {
+    case 0: onScreenshotClicked(); break;
+    case 1: onShowAllClicked(); break;
+    case 2: onHideAllClicked(); break;
+    case 3: onToggleGridClicked(); break;
+    default: break;
+    }
+}
+
 void VulkanWidget::positionButtons(const QSize& renderSize) {
     const int x = renderSize.width() - BUTTON_WIDTH - SPACING;
 
@@ -511,15 +963,18 @@ void VulkanWidget::focusOutEvent(QFocusEvent* event) {
     if (ui->overlayWidget) {
         ui->overlayWidget->hide();
     }
+    // Releases are not delivered once focus is gone; drop held camera keys so idle frames stop
+    const QSet<int> heldKeys = m_heldCameraKeys;
+    for (int key : heldKeys) {
+        setCameraKey(key, false);
+    }
     QMainWindow::focusOutEvent(event);
 }
 
 void VulkanWidget::focusInEvent(QFocusEvent* event) {
     // Show overlay when window gains focus
     if (m_overlayInitialized) {
-        QTimer::singleShot(10, this, [this]() {
-            updateOverlayGeometry();
-            });
+        scheduleOverlayUpdate();
     }
     QMainWindow::focusInEvent(event);
 }
@@ -535,11 +990,9 @@ void VulkanWidget::closeEvent(QCloseEvent* event) {
 void VulkanWidget::resizeEvent(QResizeEvent* event) {
     QMainWindow::resizeEvent(event);
 
-    // Update overlay geometry with a small delay to ensure proper positioning
+    // Update overlay geometry on the next frame tick (coalesced)
     if (m_overlayInitialized) {
-        QTimer::singleShot(10, this, [this]() {
-            updateOverlayGeometry();
-            });
+        scheduleOverlayUpdate();
     }
 }
 
@@ -555,17 +1008,13 @@ void VulkanWidget::changeEvent(QEvent* event) {
             ui->overlayWidget->hide();
         }
         else {
-            QTimer::singleShot(50, this, [this]() {
-                updateOverlayGeometry();
-                });
+            scheduleOverlayUpdate();
         }
     }
     else if (event->type() == QEvent::ActivationChange) {
         // Handle window activation/deactivation
         if (m_overlayInitialized) {
-            QTimer::singleShot(10, this, [this]() {
-                updateOverlayGeometry();
-                });
+            scheduleOverlayUpdate();
         }
     }
 }
@@ -575,9 +1024,7 @@ void VulkanWidget::moveEvent(QMoveEvent* event) {
 
     // Update overlay position when window moves
     if (m_overlayInitialized) {
-        QTimer::singleShot(10, this, [this]() {
-            updateOverlayGeometry();
-            });
+        scheduleOverlayUpdate();
     }
 }
 
@@ -639,9 +1086,7 @@ bool VulkanWidget::eventFilter(QObject* watched, QEvent* event) {
         if (watched == this) {
             switch (event->type()) {
             case QEvent::WindowActivate:
-                QTimer::singleShot(10, this, [this]() {
-                    updateOverlayGeometry();
-                    });
+                scheduleOverlayUpdate();
                 break;
             case QEvent::WindowDeactivate:
                 if (ui->overlayWidget) {
@@ -650,9 +1095,7 @@ bool VulkanWidget::eventFilter(QObject* watched, QEvent* event) {
                 break;
             case QEvent::Show:
                 if (this->isActiveWindow()) {
-                    QTimer::singleShot(50, this, [this]() {
-                        updateOverlayGeometry();
-                        });
+                    scheduleOverlayUpdate();
                 }
                 break;
             case QEvent::Hide:
@@ -670,9 +1113,7 @@ bool VulkanWidget::eventFilter(QObject* watched, QEvent* event) {
             if (event->type() == QEvent::Resize || event->type() == QEvent::Show) {
                 QSize size = ui->vulkanContainer->size();
                 if (size.width() > 50 && size.height() > 50) {
-                    QTimer::singleShot(10, this, [this]() {
-                        updateOverlayGeometry();
-                        });
+                    scheduleOverlayUpdate();
                 }
                 else {
                     ui->overlayWidget->hide();
@@ -700,6 +1141,7 @@ QVulkanInstance* VulkanWidget::createVulkanInstance() {
 
 //========================================================
 void VulkanWidget::setupDesign() {
+    TRACE_SCOPE("ui", "applyStyleSheets");
 
     // Remove all margins and spacing from central widget
     QLayout* layout = ui->centralwidget->layout();
@@ -780,7 +1222,7 @@ void VulkanWidget::setupDesign() {
     );
 
     QString treeCheckboxHideCSS = R"(
-        QTreeWidget::indicator {
+        QTreeView::indicator {
             width: 0px;
             height: 0px;
             margin: 0px;
@@ -789,8 +1231,8 @@ void VulkanWidget::setupDesign() {
             background: none;
         }
         
-        QTreeWidget::indicator:unchecked,
-        QTreeWidget::indicator:checked {
+        QTreeView::indicator:unchecked,
+        QTreeView::indicator:checked {
             width: 0px;
             height: 0px;
             margin: 0px;
@@ -1414,15 +1856,19 @@ void VulkanWidget::applyNavigationStyles() {
 
 
 void VulkanWidget::keyPressEvent(QKeyEvent* event) {
-    if (m_vulkanWindow && m_vulkanWindow->getRenderer()) {
-        m_vulkanWindow->getRenderer()->setKeyPressed(event->key(), true);
+    // Auto-repeat only re-sends a key that is already down
+    if (!event->isAutoRepeat()) {
+        recordSessionCommand(SessionCommand::KeyState, event->key(), true);
+        setCameraKey(event->key(), true);
     }
     QMainWindow::keyPressEvent(event);
 }
 
 void VulkanWidget::keyReleaseEvent(QKeyEvent* event) {
-    if (m_vulkanWindow && m_vulkanWindow->getRenderer()) {
-        m_vulkanWindow->getRenderer()->setKeyPressed(event->key(), false);
+    // Auto-repeat only re-sends a key that is already down
+    if (!event->isAutoRepeat()) {
+        recordSessionCommand(SessionCommand::KeyState, event->key(), false);
+        setCameraKey(event->key(), false);
     }
     QMainWindow::keyReleaseEvent(event);
 }
@@ -1575,18 +2021,11 @@ void VulkanWidget::setupPropertiesPanel() {
         tree->setItemWidget(inputItem, 1, widget);
     }
 
-    // Connect value change signals
-    connect(m_translateXSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &VulkanWidget::onTranslateSpinChanged);
-    connect(m_translateYSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &VulkanWidget::onTranslateSpinChanged);
-    connect(m_translateZSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &VulkanWidget::onTranslateSpinChanged);
-
-    connect(m_rotateXSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &VulkanWidget::onRotateSpinChanged);
-    connect(m_rotateYSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &VulkanWidget::onRotateSpinChanged);
-    connect(m_rotateZSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &VulkanWidget::onRotateSpinChanged);
-
-    connect(m_scaleXSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &VulkanWidget::onScaleSpinChanged);
-    connect(m_scaleYSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &VulkanWidget::onScaleSpinChanged);
-    connect(m_scaleZSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &VulkanWidget::onScaleSpinChanged);
+    // Spin-box changes become merged edits of the selected primitive, applied once per frame
+    m_transformPanel->setSpinBoxes(TransformPanel::Translate, m_translateXSpin, m_translateYSpin, m_translateZSpin);
+    m_transformPanel->setSpinBoxes(TransformPanel::Rotate, m_rotateXSpin, m_rotateYSpin, m_rotateZSpin);
+    m_transformPanel->setSpinBoxes(TransformPanel::Scale, m_scaleXSpin, m_scaleYSpin, m_scaleZSpin);
+    m_transformPanel->setFlushInterval(frameIntervalMs());
 
     // Styling
     QString style = R"(
@@ -1657,37 +2096,7 @@ QTreeWidget::branch {
 
 
 void VulkanWidget::updateTransformPanel(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale) {
-    // Block signals to prevent infinite loops when updating UI from code
-    QSignalBlocker xBlocker(m_translateXSpin), yBlocker(m_translateYSpin), zBlocker(m_translateZSpin);
-    QSignalBlocker rxBlocker(m_rotateXSpin), ryBlocker(m_rotateYSpin), rzBlocker(m_rotateZSpin);
-    QSignalBlocker sxBlocker(m_scaleXSpin), syBlocker(m_scaleYSpin), szBlocker(m_scaleZSpin);
-
-    m_translateXSpin->setValue(position.x);
-    m_translateYSpin->setValue(position.y);
-    m_translateZSpin->setValue(position.z);
-
-    m_rotateXSpin->setValue(rotation.x);
-    m_rotateYSpin->setValue(rotation.y);
-    m_rotateZSpin->setValue(rotation.z);
-
-    m_scaleXSpin->setValue(scale.x);
-    m_scaleYSpin->setValue(scale.y);
-    m_scaleZSpin->setValue(scale.z);
-}
-
-void VulkanWidget::onTranslateSpinChanged() {
-    glm::vec3 values(m_translateXSpin->value(), m_translateYSpin->value(), m_translateZSpin->value());
-    emit transformValuesChanged(Translate, values);
-}
-
-void VulkanWidget::onRotateSpinChanged() {
-    glm::vec3 values(m_rotateXSpin->value(), m_rotateYSpin->value(), m_rotateZSpin->value());
-    emit transformValuesChanged(Rotate, values);
-}
-
-void VulkanWidget::onScaleSpinChanged() {
-    glm::vec3 values(m_scaleXSpin->value(), m_scaleYSpin->value(), m_scaleZSpin->value());
-    emit transformValuesChanged(Scale, values);
+    m_transformPanel->setValues(position, rotation, scale);
 }
 
 // --- Implementation for Reset Button Slots ---
@@ -1699,8 +2108,8 @@ void VulkanWidget::onResetTranslate() {
     m_translateYSpin->setValue(0.0);
     m_translateZSpin->setValue(0.0);
 
-    // Manually trigger the changed signal after resetting
-    onTranslateSpinChanged();
+    // Queue the reset as one edit instead of three
+    m_transformPanel->commit(TransformPanel::Translate);
 }
 
 void VulkanWidget::onResetRotate() {
@@ -1708,7 +2117,7 @@ void VulkanWidget::onResetRotate() {
     m_rotateXSpin->setValue(0.0);
     m_rotateYSpin->setValue(0.0);
     m_rotateZSpin->setValue(0.0);
-    onRotateSpinChanged();
+    m_transformPanel->commit(TransformPanel::Rotate);
 }
 
 void VulkanWidget::onResetScale() {
@@ -1716,7 +2125,7 @@ void VulkanWidget::onResetScale() {
     m_scaleXSpin->setValue(1.0);
     m_scaleYSpin->setValue(1.0);
     m_scaleZSpin->setValue(1.0);
-    onScaleSpinChanged();
+    m_transformPanel->commit(TransformPanel::Scale);
 }
 void VulkanWidget::onResetTranslateX() {
     m_translateXSpin->setValue(0.0);
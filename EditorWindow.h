@@ -2,39 +2,38 @@
 
 #include <QMainWindow>
 #include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QPixmap>
 #include <QFocusEvent>
-#include <QStyledItemDelegate>
 #include <array>
+#include <vector>
 #include "ui_EditorWindow.h"
+#include "PrimitiveMeshCache.h"
+#include "SessionRecorder.h"
+#include "RayPicker.h"
+#include "TransformStore.h"
+#include "SlotMap.h"
+#include "FrameScheduler.h"
+#include "EyeIconDelegate.h"
+#include "CaptureSession.h"
+#include "TransformPanel.h"
 
 // Forward declarations
 class VulkanWindow;
-class QTreeWidgetItem;
+class OutlinerModel;
+class ViewportOverlay;
 class QVulkanInstance;
 class QPainter;
 class QTimer;
 class QPushButton;
 class QDoubleSpinBox;
+class QLabel;
 
 // Include glm for 3D vector types
 #include <glm/glm.hpp>
 
 
-// ===================================================================
-// == EyeIconDelegate Declaration
-// ===================================================================
-class EyeIconDelegate : public QStyledItemDelegate
-{
-    Q_OBJECT
-
-public:
-    explicit EyeIconDelegate(QObject* parent = nullptr);
-    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
-    bool editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option, const QModelIndex& index) override;
-    QPixmap createFallbackEyeIcon(bool visible) const;
-};
-
-
 // ===================================================================
 // == Main Window Declaration
 // ===================================================================
@@ -47,11 +46,73 @@ public:
 
     void setupVulkanWindow();
 
+    // Number of overlay relayouts actually applied (setGeometry + button placement)
+    quint64 overlayRelayoutCount() const { return m_overlayRelayoutCount; }
+
+    // Transform-panel edits received vs. transformValuesChanged emissions after per-frame merging
+    quint64 transformEditsQueued() const { return m_transformPanel->editsQueued(); }
+    quint64 transformUpdatesEmitted() const { return m_transformUpdatesEmitted; }
+
+    // WidgetOverlay: floating tool window over the viewport (fallback)
+    // InFrameOverlay: controls composited by the renderer, hit-tested in the Vulkan window.
+    // The renderer does not composite viewportOverlay()->image() yet, so nothing in the
+    // editor selects InFrameOverlay; switching to it now would leave invisible, clickable buttons
+    enum OverlayMode { WidgetOverlay, InFrameOverlay };
+    Q_ENUM(OverlayMode)
+
+    void setOverlayMode(OverlayMode mode);
+    OverlayMode overlayMode() const { return m_overlayMode; }
+    // Layer the renderer draws in InFrameOverlay mode (null in widget mode)
+    ViewportOverlay* viewportOverlay() const { return m_viewportOverlay; }
+
+    // Same values as TransformPanel::Channel
     enum TransformType { Translate, Rotate, Scale };
     Q_ENUM(TransformType)
 
+    enum PrimitiveKind { CubePrimitive, SpherePrimitive, CylinderPrimitive, PyramidPrimitive };
+    Q_ENUM(PrimitiveKind)
+
+    // Spawns `count` primitives of one kind and adds them to the outliner in one update.
+    // The mesh is generated once, but the renderer has no batch upload, so each object is
+    // still passed to VulkanRenderer::addPrimitive() on its own
+    void spawnPrimitives(PrimitiveKind kind, int count);
+
+    // Reuse statistics for the generated primitive meshes (CPU side; addPrimitive still copies each one)
+    PrimitiveMeshCache::Stats meshCacheStats() const { return m_meshCache.stats(); }
+
+    // Render-on-demand state and rendered/skipped frame counters (null until the viewport exists)
+    FrameScheduler* frameScheduler() const { return m_frameScheduler; }
+
+    // Timings of the last screenshot, in milliseconds
+    struct ScreenshotTiming {
+        double guiBlockMs = 0.0;  // Time the GUI thread spent on readback
+        double encodeMs = 0.0;    // PNG encode + write on the worker thread
+        double latencyMs = 0.0;   // Click to file on disk
+    };
+    ScreenshotTiming lastScreenshotTiming() const { return m_lastScreenshotTiming; }
+
+    // Image-sequence recording at a fixed rate into `directory`; stopping drains the
+    // encoders and returns the session's final counts
+    bool startImageSequence(const QString& directory, int framesPerSecond = 30);
+    CaptureSession::Stats stopImageSequence();
+    CaptureSession* captureSession() const { return m_captureSession; }
+
+    // Per-primitive transforms (outliner row order). Nothing flush()es them to the GPU yet; the
+    // renderer still receives edits through transformValuesChanged
+    TransformStore& transforms() { return m_transforms; }
+
+    // Camera used to turn viewport positions into pick rays; must be called whenever the view changes.
+    // The camera lives in VulkanRenderer, which does not report it yet, so viewport clicks do not
+    // pick: with a stale or default camera they would select the wrong primitive.
+    void setViewportCamera(const glm::mat4& view, const glm::mat4& projection);
+
+    // Selects the primitive under a viewport position (logical pixels); returns its row or -1,
+    // and -1 without selecting anything until setViewportCamera() has been called
+    int pickPrimitive(const QPointF& viewportPosition);
+
 signals:
     void transformValuesChanged(TransformType type, const glm::vec3& newValues);
+    void screenshotSaved(const QString& filePath, bool success);
 
 public slots:
     void updateTransformPanel(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale);
@@ -61,18 +122,27 @@ private slots:
     void onSphereClicked();
     void onCylinderClicked();
     void onPyramidClicked();
+    void onSpawnPrimitivesTriggered();
     void onClearClicked();
     void onScreenshotClicked();
     void onShowAllClicked();
     void onHideAllClicked();
     void onToggleGridClicked();
     void onBackgroundColorClicked();
-    void on_outlinerTree_itemChanged(QTreeWidgetItem* item, int column);
+    void onRecordImageSequenceToggled(bool checked);
+    void onCaptureTick();
+    void onFrameStatsToggled(bool checked);
+    void onRecordTraceToggled(bool checked);
+    void onRecordSessionToggled(bool checked);
+    void onReplaySessionTriggered();
+    void refreshFrameStats();
+    void onRenderOnDemandToggled(bool checked);
+    void onOutlinerVisibilityChanged(int row, PrimitiveHandle primitive, bool visible);
+    void onOutlinerVisibilityRangeChanged(const QVector<PrimitiveHandle>& primitives, bool visible);
+    void onOutlinerCurrentChanged(const QModelIndex& current);
 
-    // Slots for properties panel
-    void onTranslateSpinChanged();
-    void onRotateSpinChanged();
-    void onScaleSpinChanged();
+    // Merged transform-panel edits, delivered once per frame
+    void onTransformEdited(PrimitiveHandle primitive, TransformPanel::Channel channel, const glm::vec3& values);
 
     // CORRECTED: Reset functions moved to be slots
     void onResetTranslate();
@@ -105,6 +175,16 @@ private:
     void setupOverlayProperties(QWidget* overlay);
     void initializeButtonArray();
     void updateOverlayGeometry();
+    void scheduleOverlayUpdate();
+    int frameIntervalMs() const;
+    PrimitiveHandle selectedPrimitive() const;
+    void flushTransformEdits();
+    void markViewportDirty(FrameScheduler::DirtySources sources);
+    void setCameraKey(int key, bool pressed);
+    void setupViewportOverlay();
+    void recordSessionCommand(SessionCommand::Type type, qint32 a = 0, qint32 b = 0, const glm::vec3& vector = glm::vec3(0.0f));
+    void applySessionCommand(const SessionCommand& command);
+    void onOverlayButtonClicked(int index);
     void positionButtons(const QSize& renderSize);
 
     QTimer* m_overlayHeartbeatTimer = nullptr;
@@ -124,7 +204,25 @@ private:
     VulkanWindow* m_vulkanWindow = nullptr;
     QWidget* m_wrapper = nullptr;
     EyeIconDelegate* m_eyeDelegate = nullptr;
-    QMap<QTreeWidgetItem*, int> m_primitiveItems;
+    OutlinerModel* m_outlinerModel = nullptr;
+    PrimitiveMeshCache m_meshCache;
+    std::vector<PrimitiveMeshCache::Handle> m_primitiveMeshes; // One handle per spawned primitive
+
+    // Live primitives; outliner rows, queued edits and signals refer to them by handle
+    struct PrimitiveRecord {
+        int rendererId = -1;   // ID returned by VulkanRenderer::addPrimitive
+        int row = -1;          // Outliner row, also the index into m_transforms and the picker
+    };
+    SlotMap<PrimitiveRecord> m_primitives;
+    TransformStore m_transforms;   // One entry per primitive, indexed by outliner row
+    int m_selectedRow = -1;
+
+    // Viewport picking: one picker mesh per primitive kind, objects numbered like outliner rows
+    RayPicker m_picker;
+    QHash<int, int> m_pickMeshes;
+    glm::mat4 m_viewMatrix{ 1.0f };
+    glm::mat4 m_projectionMatrix{ 1.0f };
+    bool m_hasViewportCamera = false;
     static constexpr int BUTTON_COUNT = 4;
     static constexpr int BUTTON_WIDTH = 120;
     static constexpr int BUTTON_HEIGHT = 40;
@@ -134,6 +232,25 @@ private:
     std::array<QPushButton*, BUTTON_COUNT> m_overlayButtons;
     bool m_overlayInitialized = false;
     QTimer* m_overlayUpdateTimer = nullptr;
+    QTimer* m_overlayGeometryTimer = nullptr;
+    bool m_overlayGeometryDirty = false;
+    QRect m_lastOverlayRect;
+    quint64 m_overlayRelayoutCount = 0;
+    OverlayMode m_overlayMode = WidgetOverlay;
+    ScreenshotTiming m_lastScreenshotTiming;
+    CaptureSession* m_captureSession = nullptr;
+    QTimer* m_captureTimer = nullptr;
+    QTimer* m_frameStatsTimer = nullptr;
+    QLabel* m_frameStatsLabel = nullptr;
+    SessionRecorder m_sessionRecorder;
+    SessionReplayer* m_sessionReplayer = nullptr;
+
+    // Spin-box edits merged per primitive and applied once per display frame
+    TransformPanel* m_transformPanel = nullptr;
+    quint64 m_transformUpdatesEmitted = 0;
+    ViewportOverlay* m_viewportOverlay = nullptr;
+    FrameScheduler* m_frameScheduler = nullptr;
+    QSet<int> m_heldCameraKeys;
 
 protected:
     void keyPressEvent(QKeyEvent* event) override;
@@ -0,0 +1,140 @@
+#include "EyeIconDelegate.h"
+
+#include <QFile>
+#include <QMouseEvent>
+#include <QPainter>
+
+// ===================================================================
+// == EyeIconDelegate Implementation
+// ===================================================================
+EyeIconDelegate::EyeIconDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+{
+    // Resolve the icon locations once instead of probing resources on every paint
+    m_visibleIconPath = resolveIconPath({ ":/icons/eye_visible.png", ":/icons/icons/eye_visible.png" });
+    m_hiddenIconPath = resolveIconPath({ ":/icons/eye_hidden.png", ":/icons/icons/eye_hidden.png" });
+}
+
+QString EyeIconDelegate::resolveIconPath(const QStringList& candidates)
+{
+    for (const QString& path : candidates) {
+        if (QFile::exists(path)) {
+            return path;
+        }
+    }
+    return QString();
+}
+
+QPixmap EyeIconDelegate::loadEyeIcon(bool visible, qreal devicePixelRatio) const
+{
+    const QString& path = visible ? m_visibleIconPath : m_hiddenIconPath;
+
+    QPixmap pixmap;
+    if (!path.isEmpty()) {
+        pixmap = QPixmap(path);
+    }
+    if (pixmap.isNull()) {
+        return createFallbackEyeIcon(visible);
+    }
+
+    // Pre-scale to the device resolution so painting is a plain blit
+    const int devicePixels = qRound(ICON_SIZE * devicePixelRatio);
+    pixmap = pixmap.scaled(devicePixels, devicePixels, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+    return pixmap;
+}
+
+const QPixmap& EyeIconDelegate::eyeIcon(bool visible, qreal devicePixelRatio) const
+{
+    auto it = m_iconCache.find(devicePixelRatio);
+    if (it == m_iconCache.end()) {
+        std::array<QPixmap, 2> icons = { loadEyeIcon(false, devicePixelRatio), loadEyeIcon(true, devicePixelRatio) };
+        it = m_iconCache.insert(devicePixelRatio, icons);
+    }
+    return it.value()[visible ? 1 : 0];
+}
+
+QRect EyeIconDelegate::iconRect(const QRect& itemRect) const
+{
+    // The eye icon sits on the right side of the row
+    return QRect(itemRect.right() - ICON_SIZE - ICON_PADDING,
+        itemRect.y() + (itemRect.height() - ICON_SIZE) / 2,
+        ICON_SIZE, ICON_SIZE);
+}
+
+// Helper function to create fallback eye icons
+QPixmap EyeIconDelegate::createFallbackEyeIcon(bool visible) const
+{
+    QPixmap pixmap(16, 16);
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    if (visible) {
+        // Draw visible eye (open eye)
+        painter.setPen(QPen(Qt::black, 2));
+        painter.setBrush(Qt::NoBrush);
+
+        // Eye outline
+        painter.drawEllipse(2, 6, 12, 4);
+
+        // Pupil
+        painter.setBrush(Qt::black);
+        painter.drawEllipse(7, 7, 2, 2);
+    }
+    else {
+        // Draw hidden eye (crossed out eye)
+        painter.setPen(QPen(Qt::gray, 2));
+        painter.setBrush(Qt::NoBrush);
+
+        // Eye outline
+        painter.drawEllipse(2, 6, 12, 4);
+
+        // Cross out line
+        painter.setPen(QPen(Qt::red, 2));
+        painter.drawLine(2, 2, 14, 14);
+    }
+
+    return pixmap;
+}
+
+void EyeIconDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    // Create a copy of the style options
+    QStyleOptionViewItem newOption = option;
+
+    // COMPLETELY remove all checkbox-related features
+    newOption.features &= ~QStyleOptionViewItem::HasCheckIndicator;
+    newOption.state &= ~QStyle::State_HasFocus;
+    newOption.checkState = Qt::Unchecked;
+
+    // Draw the item background and text normally
+    QStyledItemDelegate::paint(painter, newOption, index);
+
+    // Get visibility from custom role instead of checkState
+    bool isVisible = index.data(Qt::UserRole).toBool();
+
+    const qreal devicePixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+    const QPixmap& icon = eyeIcon(isVisible, devicePixelRatio);
+    if (icon.isNull()) {
+        return;
+    }
+
+    painter->drawPixmap(iconRect(option.rect), icon);
+}
+
+bool EyeIconDelegate::editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option, const QModelIndex& index)
+{
+    if (event->type() == QEvent::MouseButtonRelease) {
+        auto mouseEvent = static_cast<QMouseEvent*>(event);
+
+        if (iconRect(option.rect).contains(mouseEvent->pos())) {
+            // Toggle using custom role instead of checkState
+            bool currentState = model->data(index, Qt::UserRole).toBool();
+            model->setData(index, !currentState, Qt::UserRole);
+            return true;
+        }
+    }
+    return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QHash>
+#include <QPixmap>
+#include <QStyledItemDelegate>
+#include <array>
+
+
+// ===================================================================
+// == EyeIconDelegate Declaration
+// ===================================================================
+// Outliner row delegate: paints the primitive's name, then an eye icon on
+// the right that toggles the row's visibility (Qt::UserRole) when clicked.
+// Icon resources are resolved once and the pixmaps are cached per device
+// pixel ratio, so painting a row is a text draw plus one blit.
+class EyeIconDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit EyeIconDelegate(QObject* parent = nullptr);
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    bool editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option, const QModelIndex& index) override;
+    QPixmap createFallbackEyeIcon(bool visible) const;
+
+private:
+    static constexpr int ICON_SIZE = 16;
+    static constexpr int ICON_PADDING = 5;
+
+    // Returns the cached eye icon for the given device pixel ratio, building it on first use
+    const QPixmap& eyeIcon(bool visible, qreal devicePixelRatio) const;
+    QPixmap loadEyeIcon(bool visible, qreal devicePixelRatio) const;
+    static QString resolveIconPath(const QStringList& candidates);
+    QRect iconRect(const QRect& itemRect) const;
+
+    // Resource paths resolved once; empty when only the fallback icon is available
+    QString m_visibleIconPath;
+    QString m_hiddenIconPath;
+    // [hidden, visible] pixmaps per device pixel ratio
+    mutable QHash<qreal, std::array<QPixmap, 2>> m_iconCache;
+};
@@ -0,0 +1,84 @@
+#include "FrameProfiler.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+std::atomic<bool> FrameProfiler::s_enabled{ false };
+
+// ===================================================================
+// == FrameProfiler Implementation
+// ===================================================================
+FrameProfiler& FrameProfiler::instance()
+{
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+void FrameProfiler::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        reset();
+    }
+}
+
+void FrameProfiler::addSample(const char* stage, double milliseconds)
+{
+    QMutexLocker locker(&m_mutex);
+
+    // Few stages exist, so a linear search (pointer compare first) beats hashing
+    Stage* target = nullptr;
+    for (Stage& existing : m_stages) {
+        if (existing.name == stage || std::strcmp(existing.name, stage) == 0) {
+            target = &existing;
+            break;
+        }
+    }
+    if (!target) {
+        m_stages.append(Stage());
+        target = &m_stages.last();
+        target->name = stage;
+    }
+
+    target->samples[target->next] = static_cast<float>(milliseconds);
+    target->next = (target->next + 1) % WINDOW_SIZE;
+    target->count = std::min(target->count + 1, WINDOW_SIZE);
+}
+
+QVector<FrameProfiler::StageStats> FrameProfiler::snapshot() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QVector<StageStats> result;
+    result.reserve(m_stages.size());
+
+    std::array<float, WINDOW_SIZE> sorted;
+    for (const Stage& stage : m_stages) {
+        if (stage.count == 0) continue;
+
+        std::copy(stage.samples.begin(), stage.samples.begin() + stage.count, sorted.begin());
+        std::sort(sorted.begin(), sorted.begin() + stage.count);
+
+        auto percentile = [&](double p) {
+            const int index = std::min(stage.count - 1, static_cast<int>(std::ceil(p * stage.count)) - 1);
+            return static_cast<double>(sorted[std::max(0, index)]);
+            };
+
+        StageStats stats;
+        stats.name = QString::fromLatin1(stage.name);
+        stats.p50 = percentile(0.50);
+        stats.p95 = percentile(0.95);
+        stats.p99 = percentile(0.99);
+        stats.samples = stage.count;
+        result.append(stats);
+    }
+    return result;
+}
+
+void FrameProfiler::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stages.clear();
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <atomic>
+
+
+// ===================================================================
+// == FrameProfiler Declaration
+// ===================================================================
+// Collects per-stage CPU scope timings into
+// rolling windows and reports p50/p95/p99 for each stage. While disabled
+// a PROFILE_SCOPE costs one relaxed atomic load; defining
+// FLEURA_NO_PROFILING compiles the scopes out entirely.
+class FrameProfiler
+{
+public:
+    static constexpr int WINDOW_SIZE = 240;   // ~4 seconds at 60 fps
+
+    struct StageStats {
+        QString name;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        int samples = 0;
+    };
+
+    static FrameProfiler& instance();
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+
+    // `stage` must be a string literal (or otherwise outlive the profiler)
+    void addSample(const char* stage, double milliseconds);
+
+    QVector<StageStats> snapshot() const;
+    void reset();
+
+private:
+    FrameProfiler() = default;
+
+    struct Stage {
+        const char* name = nullptr;
+        std::array<float, WINDOW_SIZE> samples{};
+        int count = 0;
+        int next = 0;
+    };
+
+    static std::atomic<bool> s_enabled;
+    mutable QMutex m_mutex;
+    QVector<Stage> m_stages;
+};
+
+
+// ===================================================================
+// == ProfileScope Declaration
+// ===================================================================
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* stage)
+        : m_stage(FrameProfiler::isEnabled() ? stage : nullptr)
+    {
+        if (m_stage) m_timer.start();
+    }
+
+    ~ProfileScope()
+    {
+        if (m_stage) FrameProfiler::instance().addSample(m_stage, m_timer.nsecsElapsed() / 1e6);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_stage;
+    QElapsedTimer m_timer;
+};
+
+#define FLEURA_PROFILE_CONCAT_INNER(a, b) a##b
+#define FLEURA_PROFILE_CONCAT(a, b) FLEURA_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef FLEURA_NO_PROFILING
+#define PROFILE_SCOPE(stage) do {} while (0)
+#else
+#define PROFILE_SCOPE(stage) ProfileScope FLEURA_PROFILE_CONCAT(profileScope_, __LINE__)(stage)
+#endif
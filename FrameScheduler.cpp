@@ -0,0 +1,168 @@
+#include "FrameScheduler.h"
+
+#include <QEvent>
+#include <QMouseEvent>
+#include <QScreen>
+#include <QVulkanWindow>
+#include <cmath>
+#include <memory>
+
+// ===================================================================
+// == FrameScheduler::ScheduledRenderer Implementation
+// ===================================================================
+// Decorator around the window's real renderer. startNextFrame() is the
+// only point where QVulkanWindow has committed to a frame, so that is
+// where the scheduler counts it.
+class FrameScheduler::ScheduledRenderer : public QVulkanWindowRenderer
+{
+public:
+    ScheduledRenderer(FrameScheduler* scheduler, QVulkanWindowRenderer* renderer)
+        : m_scheduler(scheduler)
+        , m_renderer(renderer)
+    {
+    }
+
+    void preInitResources() override { m_renderer->preInitResources(); }
+    void initResources() override { m_renderer->initResources(); }
+    void initSwapChainResources() override { m_renderer->initSwapChainResources(); }
+    void releaseSwapChainResources() override { m_renderer->releaseSwapChainResources(); }
+    void releaseResources() override { m_renderer->releaseResources(); }
+    void physicalDeviceLost() override { m_renderer->physicalDeviceLost(); }
+    void logicalDeviceLost() override { m_renderer->logicalDeviceLost(); }
+
+    void startNextFrame() override
+    {
+        if (m_scheduler) {
+            m_scheduler->beginFrame();
+        }
+        m_renderer->startNextFrame();
+    }
+
+private:
+    QPointer<FrameScheduler> m_scheduler;
+    std::unique_ptr<QVulkanWindowRenderer> m_renderer;
+};
+
+// ===================================================================
+// == FrameScheduler Implementation
+// ===================================================================
+FrameScheduler::FrameScheduler(QWindow* window, QObject* parent)
+    : QObject(parent)
+    , m_window(window)
+{
+    if (m_window) {
+        m_window->installEventFilter(this);
+    }
+}
+
+QVulkanWindowRenderer* FrameScheduler::wrapRenderer(QVulkanWindowRenderer* renderer)
+{
+    if (!renderer) return nullptr;
+    return new ScheduledRenderer(this, renderer);
+}
+
+void FrameScheduler::setOnDemand(bool onDemand)
+{
+    if (m_onDemand == onDemand) return;
+    m_onDemand = onDemand;
+
+    // Continuous mode needs one request to get the loop going again
+    requestFrame();
+}
+
+void FrameScheduler::markDirty(DirtySources sources)
+{
+    // Repeated requests before the next vsync collapse into one update
+    m_dirty |= sources;
+    requestFrame();
+}
+
+void FrameScheduler::setHeld(DirtySource source, bool held)
+{
+    if (held == m_held.testFlag(source)) return;
+
+    if (held) {
+        m_held |= source;
+    }
+    else {
+        m_held &= ~DirtySources(source);
+        // One more frame so the final state is shown
+        m_dirty |= source;
+    }
+    requestFrame();
+}
+
+bool FrameScheduler::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched != m_window) return QObject::eventFilter(watched, event);
+
+    switch (event->type()) {
+    case QEvent::UpdateRequest:
+        // Nothing changed since the last frame: drop the request instead of rendering.
+        // Otherwise let it through; the frame is counted if the window actually starts one
+        if (m_onDemand && !m_dirty && !m_held) return true;
+        break;
+    case QEvent::Resize:
+    case QEvent::Expose:
+        markDirty(ViewportSource);
+        break;
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::Wheel:
+        markDirty(CameraSource);
+        break;
+    case QEvent::MouseMove:
+        // Hover alone does not move the camera
+        if (static_cast<QMouseEvent*>(event)->buttons() != Qt::NoButton) {
+            markDirty(CameraSource);
+        }
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void FrameScheduler::beginFrame()
+{
+    if (m_onDemand) {
+        m_skipped += idleIntervals();
+    }
+    m_sinceLastFrame.start();
+
+    m_lastSources = m_dirty | m_held;
+    m_dirty = DirtySources();
+    emit frameStarting(m_rendered++);
+
+    // Anything marked from here on requests its own frame
+    if (!m_onDemand || m_held) {
+        requestFrame();
+    }
+}
+
+quint64 FrameScheduler::skippedFrames() const
+{
+    return m_skipped + (m_onDemand ? idleIntervals() : 0);
+}
+
+quint64 FrameScheduler::idleIntervals() const
+{
+    if (!m_sinceLastFrame.isValid()) return 0;
+
+    // Refreshes that passed since the last frame, minus the one the next frame will use
+    const double intervals = std::floor(m_sinceLastFrame.nsecsElapsed() / 1e6 / frameIntervalMs());
+    return intervals > 1.0 ? static_cast<quint64>(intervals) - 1 : 0;
+}
+
+double FrameScheduler::frameIntervalMs() const
+{
+    const qreal refreshRate = m_window && m_window->screen() ? m_window->screen()->refreshRate() : 60.0;
+    return 1000.0 / (refreshRate > 0.0 ? refreshRate : 60.0);
+}
+
+void FrameScheduler::requestFrame()
+{
+    if (m_window) {
+        m_window->requestUpdate();
+    }
+}
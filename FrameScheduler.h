@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QWindow>
+
+class QEvent;
+class QVulkanWindowRenderer;
+
+
+// ===================================================================
+// == FrameScheduler Declaration
+// ===================================================================
+// Render-on-demand gate for the viewport window. QVulkanWindow records
+// one frame per UpdateRequest event, so the scheduler filters those
+// events: a request only gets through while a source is dirty or held.
+// Dropping it also stops the renderer's own request-per-frame loop, and
+// the next markDirty() restarts it at the following vsync.
+//
+// A request that gets through is not necessarily a frame: QVulkanWindow
+// skips it while there is no swapchain or a frame is still pending. So
+// frames are counted, and dirty state consumed, from the renderer's
+// startNextFrame(), which wrapRenderer() hooks.
+class FrameScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum DirtySource {
+        SceneSource = 0x01,        // Primitives added, removed, hidden or moved
+        CameraSource = 0x02,       // Camera keys and mouse input on the viewport
+        ViewportSource = 0x04,     // Resize or expose
+        AppearanceSource = 0x08,   // Background colour, grid
+        OverlaySource = 0x10,      // In-frame overlay image
+        AllSources = 0x1F
+    };
+    Q_DECLARE_FLAGS(DirtySources, DirtySource)
+    Q_FLAG(DirtySources)
+
+    // Installs itself as an event filter on `window`
+    explicit FrameScheduler(QWindow* window, QObject* parent = nullptr);
+
+    // Returns a renderer that forwards to `renderer` (and owns it) and starts a scheduler frame at
+    // the top of every startNextFrame(). Return it from the window's createRenderer().
+    QVulkanWindowRenderer* wrapRenderer(QVulkanWindowRenderer* renderer);
+
+    // Off = every update request renders (the previous behaviour)
+    void setOnDemand(bool onDemand);
+    bool isOnDemand() const { return m_onDemand; }
+
+    void markDirty(DirtySources sources);
+
+    // While any source is held, every vsync renders
+    void setHeld(DirtySource source, bool held);
+    bool isHeld() const { return m_held != 0; }
+
+    quint64 renderedFrames() const { return m_rendered; }
+    // Display refreshes that did not render while in on-demand mode, including the current idle span
+    quint64 skippedFrames() const;
+    DirtySources lastFrameSources() const { return m_lastSources; }
+
+signals:
+    // Emitted when the window starts recording frame `frameNumber` (counted from 0), before the renderer
+    void frameStarting(quint64 frameNumber);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    class ScheduledRenderer;
+
+    void beginFrame();
+    double frameIntervalMs() const;
+    quint64 idleIntervals() const;
+    void requestFrame();
+
+    QPointer<QWindow> m_window;
+    bool m_onDemand = true;
+    DirtySources m_dirty = AllSources;
+    DirtySources m_held;
+    DirtySources m_lastSources;
+    quint64 m_rendered = 0;
+    quint64 m_skipped = 0;
+    QElapsedTimer m_sinceLastFrame;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(FrameScheduler::DirtySources)
@@ -0,0 +1,267 @@
+#include "GpuMemoryArena.h"
+
+#include <QVulkanDeviceFunctions>
+#include <algorithm>
+#include <cassert>
+
+// ===================================================================
+// == GpuMemoryArena::VulkanBackend Implementation
+// ===================================================================
+VkDeviceMemory GpuMemoryArena::VulkanBackend::allocateBlock(VkDeviceSize size, uint32_t memoryTypeIndex)
+{
+    VkMemoryAllocateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    info.allocationSize = size;
+    info.memoryTypeIndex = memoryTypeIndex;
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (m_functions->vkAllocateMemory(m_device, &info, nullptr, &memory) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+    return memory;
+}
+
+void GpuMemoryArena::VulkanBackend::freeBlock(VkDeviceMemory memory)
+{
+    m_functions->vkFreeMemory(m_device, memory, nullptr);
+}
+
+// ===================================================================
+// == GpuMemoryArena Implementation
+// ===================================================================
+GpuMemoryArena::~GpuMemoryArena()
+{
+    destroy();
+}
+
+void GpuMemoryArena::create(Backend* backend, uint32_t memoryTypeIndex, VkDeviceSize blockSize)
+{
+    destroy();
+
+    m_backend = backend;
+    m_memoryTypeIndex = memoryTypeIndex;
+    m_blockSize = blockSize & ~(TlsfAllocator::GRANULARITY - 1);
+}
+
+void GpuMemoryArena::destroy()
+{
+    if (m_backend) {
+        for (auto& block : m_blocks) {
+            if (block) m_backend->freeBlock(block->memory);
+        }
+    }
+    m_blocks.clear();
+    m_allocations.clear();
+    m_freeRecords = NULL_ALLOCATION;
+    m_pendingSources.clear();
+}
+
+int GpuMemoryArena::createBlock(VkDeviceSize size, bool dedicated)
+{
+    const VkDeviceMemory memory = m_backend->allocateBlock(size, m_memoryTypeIndex);
+    if (memory == VK_NULL_HANDLE) return -1;
+
+    std::unique_ptr<Block> block(new Block());
+    block->memory = memory;
+    block->allocator.reset(size);
+    block->dedicated = dedicated;
+
+    // Reuse a released slot so block indices stay small
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        if (!m_blocks[i]) {
+            m_blocks[i] = std::move(block);
+            return static_cast<int>(i);
+        }
+    }
+    m_blocks.push_back(std::move(block));
+    return static_cast<int>(m_blocks.size()) - 1;
+}
+
+int GpuMemoryArena::allocateFromBlocks(VkDeviceSize size, VkDeviceSize alignment, int& range)
+{
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        Block* block = m_blocks[i].get();
+        if (!block || block->dedicated) continue;
+
+        range = block->allocator.allocate(size, alignment);
+        if (range != TlsfAllocator::NULL_RANGE) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int GpuMemoryArena::allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    if (!m_backend || size == 0) return NULL_ALLOCATION;
+    alignment = std::max<VkDeviceSize>(alignment, 1);
+
+    int range = TlsfAllocator::NULL_RANGE;
+    int block = -1;
+    if (size + alignment > m_blockSize) {
+        // Too big to share a block
+        block = createBlock((size + TlsfAllocator::GRANULARITY - 1) & ~(TlsfAllocator::GRANULARITY - 1), true);
+        if (block < 0) return NULL_ALLOCATION;
+        // Offset 0 of device memory satisfies any buffer alignment
+        range = m_blocks[block]->allocator.allocate(size, TlsfAllocator::GRANULARITY);
+    }
+    else {
+        block = allocateFromBlocks(size, alignment, range);
+        if (block < 0) {
+            block = createBlock(m_blockSize, false);
+            if (block < 0) return NULL_ALLOCATION;
+            range = m_blocks[block]->allocator.allocate(size, alignment);
+        }
+    }
+    assert(range != TlsfAllocator::NULL_RANGE);
+
+    int id;
+    if (m_freeRecords != NULL_ALLOCATION) {
+        id = m_freeRecords;
+        m_freeRecords = m_allocations[id].nextFree;
+    }
+    else {
+        id = static_cast<int>(m_allocations.size());
+        m_allocations.emplace_back();
+    }
+
+    Record& record = m_allocations[id];
+    record.block = block;
+    record.range = range;
+    record.live = true;
+    record.nextFree = NULL_ALLOCATION;
+    record.allocation.memory = m_blocks[block]->memory;
+    record.allocation.offset = m_blocks[block]->allocator.offset(range);
+    record.allocation.size = size;
+    record.alignment = alignment;
+    return id;
+}
+
+void GpuMemoryArena::free(int allocation)
+{
+    Record& record = m_allocations[allocation];
+    assert(record.live);
+
+    Block& block = *m_blocks[record.block];
+    block.allocator.free(record.range);
+
+    record = Record();
+    record.nextFree = m_freeRecords;
+    m_freeRecords = allocation;
+
+    // Dedicated blocks go straight back; shared blocks are kept for reuse
+    if (block.dedicated && !isDefragmenting()) {
+        releaseEmptyBlocks();
+    }
+}
+
+void GpuMemoryArena::releaseEmptyBlocks()
+{
+    // Keep one empty shared block around to absorb the next allocation without a driver call
+    bool keptSpare = false;
+    for (auto& block : m_blocks) {
+        if (!block || !block->allocator.isEmpty()) continue;
+        if (!block->dedicated && !keptSpare) {
+            keptSpare = true;
+            continue;
+        }
+        m_backend->freeBlock(block->memory);
+        block.reset();
+    }
+}
+
+GpuMemoryArena::Stats GpuMemoryArena::stats() const
+{
+    Stats stats;
+    for (const auto& block : m_blocks) {
+        if (!block) continue;
+
+        const TlsfAllocator& allocator = block->allocator;
+        ++stats.blockCount;
+        stats.reservedBytes += allocator.size();
+        stats.usedBytes += allocator.usedBytes();
+        stats.freeBytes += allocator.freeBytes();
+        stats.freeRangeCount += allocator.freeRangeCount();
+        stats.largestFreeRange = std::max<VkDeviceSize>(stats.largestFreeRange, allocator.largestFreeRange());
+    }
+
+    VkDeviceSize requestedBytes = 0;
+    for (const Record& record : m_allocations) {
+        if (!record.live) continue;
+        ++stats.allocationCount;
+        requestedBytes += record.allocation.size;
+    }
+    // Alignment padding is split off as a free range, so only the rounding up to
+    // GRANULARITY is lost inside allocations
+    stats.wastedBytes = stats.usedBytes - std::min(stats.usedBytes, requestedBytes);
+
+    if (stats.freeBytes > 0) {
+        stats.fragmentation = 1.0 - double(stats.largestFreeRange) / double(stats.freeBytes);
+    }
+    return stats;
+}
+
+std::vector<GpuMemoryArena::Move> GpuMemoryArena::planDefragmentation(VkDeviceSize maxBytes)
+{
+    std::vector<Move> moves;
+    if (isDefragmenting()) return moves;
+
+    // Shared blocks ordered from emptiest to fullest; the emptiest are evacuated first
+    std::vector<int> order;
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        if (m_blocks[i] && !m_blocks[i]->dedicated && !m_blocks[i]->allocator.isEmpty()) {
+            order.push_back(static_cast<int>(i));
+        }
+    }
+    if (order.size() < 2) return moves;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return m_blocks[a]->allocator.usedBytes() < m_blocks[b]->allocator.usedBytes();
+        });
+
+    VkDeviceSize movedBytes = 0;
+    for (size_t source = 0; source + 1 < order.size() && movedBytes < maxBytes; ++source) {
+        const int sourceBlock = order[source];
+
+        for (size_t id = 0; id < m_allocations.size() && movedBytes < maxBytes; ++id) {
+            Record& record = m_allocations[id];
+            if (!record.live || record.block != sourceBlock) continue;
+
+            // Only move into blocks that are fuller than the source; the source range
+            // stays reserved until finishDefragmentation(), so nothing overlaps
+            int range = TlsfAllocator::NULL_RANGE;
+            int target = -1;
+            for (size_t candidate = order.size() - 1; candidate > source; --candidate) {
+                range = m_blocks[order[candidate]]->allocator.allocate(record.allocation.size, record.alignment);
+                if (range != TlsfAllocator::NULL_RANGE) {
+                    target = order[candidate];
+                    break;
+                }
+            }
+            if (target < 0) continue;
+
+            Move move;
+            move.allocation = static_cast<int>(id);
+            move.srcMemory = record.allocation.memory;
+            move.srcOffset = record.allocation.offset;
+            move.dstMemory = m_blocks[target]->memory;
+            move.dstOffset = m_blocks[target]->allocator.offset(range);
+            move.size = record.allocation.size;
+            moves.push_back(move);
+
+            m_pendingSources.push_back({ record.block, record.range });
+            record.block = target;
+            record.range = range;
+            record.allocation.memory = move.dstMemory;
+            record.allocation.offset = move.dstOffset;
+            movedBytes += move.size;
+        }
+    }
+    return moves;
+}
+
+void GpuMemoryArena::finishDefragmentation()
+{
+    for (const PendingSource& source : m_pendingSources) {
+        m_blocks[source.block]->allocator.free(source.range);
+    }
+    m_pendingSources.clear();
+    releaseEmptyBlocks();
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "TlsfAllocator.h"
+
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+class QVulkanDeviceFunctions;
+
+
+// ===================================================================
+// == GpuMemoryArena Declaration
+// ===================================================================
+// Sub-allocates vertex and index buffer memory out of a few large blocks
+// of one memory type, so scenes with many meshes make a handful of
+// vkAllocateMemory calls instead of one per primitive. Each block is
+// managed by a TlsfAllocator; requests larger than a block get a block
+// of their own. Device memory comes from a Backend, so the allocation
+// logic can also run against a mock device. Only the tests use it so
+// far; VulkanRenderer still allocates memory per buffer.
+class GpuMemoryArena
+{
+public:
+    class Backend
+    {
+    public:
+        virtual ~Backend() = default;
+        virtual VkDeviceMemory allocateBlock(VkDeviceSize size, uint32_t memoryTypeIndex) = 0;
+        virtual void freeBlock(VkDeviceMemory memory) = 0;
+    };
+
+    // Backend over vkAllocateMemory / vkFreeMemory
+    class VulkanBackend : public Backend
+    {
+    public:
+        VulkanBackend(VkDevice device, QVulkanDeviceFunctions* functions) : m_device(device), m_functions(functions) {}
+        VkDeviceMemory allocateBlock(VkDeviceSize size, uint32_t memoryTypeIndex) override;
+        void freeBlock(VkDeviceMemory memory) override;
+
+    private:
+        VkDevice m_device;
+        QVulkanDeviceFunctions* m_functions;
+    };
+
+    static constexpr int NULL_ALLOCATION = -1;
+
+    struct Allocation {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;   // Requested size
+    };
+
+    struct Stats {
+        int blockCount = 0;
+        int allocationCount = 0;
+        VkDeviceSize reservedBytes = 0;   // Device memory held by blocks
+        VkDeviceSize usedBytes = 0;       // Handed out, including rounding
+        VkDeviceSize wastedBytes = 0;     // Granularity rounding inside allocations; alignment padding stays free
+        VkDeviceSize freeBytes = 0;
+        VkDeviceSize largestFreeRange = 0;
+        int freeRangeCount = 0;
+        double fragmentation = 0.0;       // 1 - largest free range / free bytes
+    };
+
+    // One relocation: copy `size` bytes from the source range to the allocation's new location
+    struct Move {
+        int allocation = NULL_ALLOCATION;
+        VkDeviceMemory srcMemory = VK_NULL_HANDLE;
+        VkDeviceSize srcOffset = 0;
+        VkDeviceMemory dstMemory = VK_NULL_HANDLE;
+        VkDeviceSize dstOffset = 0;
+        VkDeviceSize size = 0;
+    };
+
+    GpuMemoryArena() = default;
+    ~GpuMemoryArena();
+    GpuMemoryArena(const GpuMemoryArena&) = delete;
+    GpuMemoryArena& operator=(const GpuMemoryArena&) = delete;
+
+    void create(Backend* backend, uint32_t memoryTypeIndex, VkDeviceSize blockSize = 64ull * 1024 * 1024);
+    void destroy();
+
+    // Returns an allocation ID, or NULL_ALLOCATION when device memory is exhausted
+    int allocate(VkDeviceSize size, VkDeviceSize alignment);
+    void free(int allocation);
+
+    const Allocation& allocation(int id) const { return m_allocations[id].allocation; }
+
+    Stats stats() const;
+
+    // Idle-frame compaction. Moves live allocations out of the emptiest blocks into
+    // fuller ones, up to `maxBytes`. allocation() already reports the new location;
+    // the caller copies the data and rebinds its buffers, then calls
+    // finishDefragmentation() once those copies have completed on the GPU, which
+    // releases the source ranges and frees blocks that became empty.
+    std::vector<Move> planDefragmentation(VkDeviceSize maxBytes);
+    void finishDefragmentation();
+    bool isDefragmenting() const { return !m_pendingSources.empty(); }
+
+private:
+    struct Block {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        TlsfAllocator allocator;
+        bool dedicated = false;
+    };
+
+    struct Record {
+        Allocation allocation;
+        VkDeviceSize alignment = 1;
+        int block = -1;
+        int range = TlsfAllocator::NULL_RANGE;
+        int nextFree = NULL_ALLOCATION;   // Pool link while unused
+        bool live = false;
+    };
+
+    struct PendingSource {
+        int block;
+        int range;
+    };
+
+    int allocateFromBlocks(VkDeviceSize size, VkDeviceSize alignment, int& range);
+    int createBlock(VkDeviceSize size, bool dedicated);
+    void releaseEmptyBlocks();
+
+    Backend* m_backend = nullptr;
+    uint32_t m_memoryTypeIndex = 0;
+    VkDeviceSize m_blockSize = 0;
+    std::vector<std::unique_ptr<Block>> m_blocks;   // Null entries are released blocks
+    std::vector<Record> m_allocations;
+    int m_freeRecords = NULL_ALLOCATION;
+    std::vector<PendingSource> m_pendingSources;
+};
@@ -0,0 +1,272 @@
+#include "OcclusionCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef FLEURA_OCCLUSION_SSE
+#include <emmintrin.h>
+#endif
+
+namespace {
+    int nextPowerOfTwo(int value)
+    {
+        int result = 4;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    // Corner index bits: x = 1, y = 2, z = 4
+    const int BOX_TRIANGLES[12][3] = {
+        { 0, 1, 3 }, { 0, 3, 2 },   // -Z
+        { 4, 6, 7 }, { 4, 7, 5 },   // +Z
+        { 0, 4, 5 }, { 0, 5, 1 },   // -Y
+        { 2, 3, 7 }, { 2, 7, 6 },   // +Y
+        { 0, 2, 6 }, { 0, 6, 4 },   // -X
+        { 1, 5, 7 }, { 1, 7, 3 },   // +X
+    };
+}
+
+// ===================================================================
+// == OcclusionCuller Implementation
+// ===================================================================
+OcclusionCuller::OcclusionCuller(int width, int height)
+    : m_width(nextPowerOfTwo(width))
+    , m_height(nextPowerOfTwo(height))
+{
+    int w = m_width;
+    int h = m_height;
+    for (;;) {
+        m_levels.emplace_back(size_t(w) * h, 1.0f);
+        if (w == 1 && h == 1) break;
+        w = std::max(1, w >> 1);
+        h = std::max(1, h >> 1);
+    }
+}
+
+void OcclusionCuller::beginFrame(const glm::mat4& viewProjection)
+{
+    m_viewProjection = viewProjection;
+    m_stats = Stats();
+    std::fill(m_levels[0].begin(), m_levels[0].end(), 1.0f);
+}
+
+bool OcclusionCuller::project(const Aabb& box, glm::vec3 corners[8], ScreenBounds& bounds) const
+{
+    bounds = { 1e30f, 1e30f, -1e30f, -1e30f, 1.0f, 0.0f };
+
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec4 world((i & 1) ? box.max.x : box.min.x,
+            (i & 2) ? box.max.y : box.min.y,
+            (i & 4) ? box.max.z : box.min.z, 1.0f);
+        const glm::vec4 clip = m_viewProjection * world;
+
+        // Crossing the near plane: no reliable screen projection
+        if (clip.w <= 1e-5f || clip.z < 0.0f) return false;
+
+        const float invW = 1.0f / clip.w;
+        const glm::vec3 screen((clip.x * invW * 0.5f + 0.5f) * m_width,
+            (clip.y * invW * 0.5f + 0.5f) * m_height,
+            clip.z * invW);
+        corners[i] = screen;
+
+        bounds.minX = std::min(bounds.minX, screen.x);
+        bounds.minY = std::min(bounds.minY, screen.y);
+        bounds.maxX = std::max(bounds.maxX, screen.x);
+        bounds.maxY = std::max(bounds.maxY, screen.y);
+        bounds.minDepth = std::min(bounds.minDepth, screen.z);
+        bounds.maxDepth = std::max(bounds.maxDepth, screen.z);
+    }
+    return true;
+}
+
+void OcclusionCuller::rasterizeOccluders(const Aabb* boxes, int count, int maxOccluders)
+{
+    // Rank candidates by projected screen area
+    m_ranking.clear();
+    glm::vec3 corners[8];
+    ScreenBounds bounds;
+    for (int i = 0; i < count; ++i) {
+        if (!project(boxes[i], corners, bounds)) continue;
+
+        const float area = std::max(0.0f, std::min(bounds.maxX, float(m_width)) - std::max(bounds.minX, 0.0f))
+            * std::max(0.0f, std::min(bounds.maxY, float(m_height)) - std::max(bounds.minY, 0.0f));
+        if (area > 1.0f) {
+            m_ranking.emplace_back(area, i);
+        }
+    }
+
+    const int selected = std::min(maxOccluders, static_cast<int>(m_ranking.size()));
+    std::partial_sort(m_ranking.begin(), m_ranking.begin() + selected, m_ranking.end(),
+        [](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; });
+
+    for (int i = 0; i < selected; ++i) {
+        rasterizeOccluder(boxes[m_ranking[i].second]);
+    }
+}
+
+void OcclusionCuller::rasterizeOccluder(const Aabb& box)
+{
+    glm::vec3 corners[8];
+    ScreenBounds bounds;
+    if (!project(box, corners, bounds) || bounds.maxX < 0.0f || bounds.maxY < 0.0f
+        || bounds.minX >= m_width || bounds.minY >= m_height) {
+        ++m_stats.occludersRejected;
+        return;
+    }
+
+    // All faces are drawn; back faces lose the nearest-depth test anyway
+    for (const auto& triangle : BOX_TRIANGLES) {
+        rasterizeTriangle(corners[triangle[0]], corners[triangle[1]], corners[triangle[2]]);
+    }
+    ++m_stats.occludersRasterized;
+}
+
+void OcclusionCuller::rasterizeTriangle(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2)
+{
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (std::fabs(area) < 1e-6f) return;
+
+    // Normalise winding so inside means all edge functions >= 0
+    const glm::vec3& a = v0;
+    const glm::vec3& b = area > 0.0f ? v1 : v2;
+    const glm::vec3& c = area > 0.0f ? v2 : v1;
+    area = std::fabs(area);
+
+    const int minX = std::max(0, static_cast<int>(std::floor(std::min({ a.x, b.x, c.x }))));
+    const int maxX = std::min(m_width - 1, static_cast<int>(std::ceil(std::max({ a.x, b.x, c.x }))));
+    const int minY = std::max(0, static_cast<int>(std::floor(std::min({ a.y, b.y, c.y }))));
+    const int maxY = std::min(m_height - 1, static_cast<int>(std::ceil(std::max({ a.y, b.y, c.y }))));
+    if (minX > maxX || minY > maxY) return;
+
+    // Edge functions E(x, y) = A*x + B*y + C, evaluated at pixel centres
+    const float A0 = b.y - c.y, B0 = c.x - b.x, C0 = b.x * c.y - b.y * c.x;
+    const float A1 = c.y - a.y, B1 = a.x - c.x, C1 = c.x * a.y - c.y * a.x;
+    const float A2 = a.y - b.y, B2 = b.x - a.x, C2 = a.x * b.y - a.y * b.x;
+
+    // Depth is affine in screen space: z = Az*x + Bz*y + Cz
+    const float invArea = 1.0f / area;
+    const float Az = (A0 * a.z + A1 * b.z + A2 * c.z) * invArea;
+    const float Bz = (B0 * a.z + B1 * b.z + B2 * c.z) * invArea;
+    const float Cz = (C0 * a.z + C1 * b.z + C2 * c.z) * invArea;
+
+    float* depth = m_levels[0].data();
+
+#ifdef FLEURA_OCCLUSION_SSE
+    // Four horizontally adjacent pixels per step; the buffer width is a multiple of 4
+    const int startX = minX & ~3;
+    const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    for (int y = minY; y <= maxY; ++y) {
+        const float py = y + 0.5f;
+        float* row = depth + size_t(y) * m_width;
+        for (int x = startX; x <= maxX; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(float(x)), offsets);
+            const __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A0), px), _mm_set1_ps(B0 * py + C0));
+            const __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A1), px), _mm_set1_ps(B1 * py + C1));
+            const __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A2), px), _mm_set1_ps(B2 * py + C2));
+            const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+            if (_mm_movemask_ps(inside) == 0) continue;
+
+            const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(Az), px), _mm_set1_ps(Bz * py + Cz));
+            const __m128 old = _mm_loadu_ps(row + x);
+            const __m128 nearest = _mm_min_ps(old, z);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+        }
+    }
+#else
+    for (int y = minY; y <= maxY; ++y) {
+        const float py = y + 0.5f;
+        float* row = depth + size_t(y) * m_width;
+        for (int x = minX; x <= maxX; ++x) {
+            const float px = x + 0.5f;
+            if (A0 * px + B0 * py + C0 < 0.0f || A1 * px + B1 * py + C1 < 0.0f || A2 * px + B2 * py + C2 < 0.0f) continue;
+
+            const float z = Az * px + Bz * py + Cz;
+            row[x] = std::min(row[x], z);
+        }
+    }
+#endif
+}
+
+void OcclusionCuller::buildHierarchy()
+{
+    for (int level = 1; level < levelCount(); ++level) {
+        downsample(level);
+    }
+}
+
+void OcclusionCuller::downsample(int level)
+{
+    // Each texel keeps the farthest depth of the 2x2 block below it
+    const int srcWidth = levelWidth(level - 1);
+    const int srcHeight = levelHeight(level - 1);
+    const int dstWidth = levelWidth(level);
+    const int dstHeight = levelHeight(level);
+    const float* src = m_levels[level - 1].data();
+    float* dst = m_levels[level].data();
+
+    for (int y = 0; y < dstHeight; ++y) {
+        const float* row0 = src + size_t(std::min(y * 2, srcHeight - 1)) * srcWidth;
+        const float* row1 = src + size_t(std::min(y * 2 + 1, srcHeight - 1)) * srcWidth;
+        float* out = dst + size_t(y) * dstWidth;
+
+        int x = 0;
+#ifdef FLEURA_OCCLUSION_SSE
+        if (srcWidth >= 8) {
+            for (; x + 4 <= dstWidth; x += 4) {
+                // Vertical max of 8 source texels, then max of adjacent pairs
+                const __m128 a = _mm_max_ps(_mm_loadu_ps(row0 + x * 2), _mm_loadu_ps(row1 + x * 2));
+                const __m128 b = _mm_max_ps(_mm_loadu_ps(row0 + x * 2 + 4), _mm_loadu_ps(row1 + x * 2 + 4));
+                const __m128 even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                const __m128 odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                _mm_storeu_ps(out + x, _mm_max_ps(even, odd));
+            }
+        }
+#endif
+        for (; x < dstWidth; ++x) {
+            const int x0 = std::min(x * 2, srcWidth - 1);
+            const int x1 = std::min(x * 2 + 1, srcWidth - 1);
+            out[x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+        }
+    }
+}
+
+bool OcclusionCuller::isVisible(const Aabb& box)
+{
+    ++m_stats.tested;
+
+    glm::vec3 corners[8];
+    ScreenBounds bounds;
+    if (!project(box, corners, bounds)) return true;
+
+    // Off screen boxes are the frustum culler's job; treat them as visible here
+    const int minX = std::max(0, static_cast<int>(std::floor(bounds.minX)));
+    const int minY = std::max(0, static_cast<int>(std::floor(bounds.minY)));
+    const int maxX = std::min(m_width - 1, static_cast<int>(std::ceil(bounds.maxX)));
+    const int maxY = std::min(m_height - 1, static_cast<int>(std::ceil(bounds.maxY)));
+    if (minX > maxX || minY > maxY) return true;
+
+    // Coarsest level where the footprint spans at most 2 texels per axis
+    const int extent = std::max(maxX - minX, maxY - minY);
+    int level = 0;
+    while ((extent >> level) > 1 && level + 1 < levelCount()) ++level;
+
+    const int levelMaxX = std::min(maxX >> level, levelWidth(level) - 1);
+    const int levelMaxY = std::min(maxY >> level, levelHeight(level) - 1);
+    const float* depth = m_levels[level].data();
+    const int stride = levelWidth(level);
+
+    float farthest = 0.0f;
+    for (int y = minY >> level; y <= levelMaxY; ++y) {
+        for (int x = minX >> level; x <= levelMaxX; ++x) {
+            farthest = std::max(farthest, depth[size_t(y) * stride + x]);
+        }
+    }
+
+    // Hidden only if everything drawn there is nearer than the box's nearest point
+    if (farthest < bounds.minDepth) {
+        ++m_stats.culled;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Bounds.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// SSE2 is baseline on every x86-64 target we build for (and on 32-bit MSVC with /arch:SSE2)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLEURA_OCCLUSION_SSE 1
+#endif
+
+
+// ===================================================================
+// == OcclusionCuller Declaration
+// ===================================================================
+// Small CPU software rasterizer for occlusion culling. The biggest
+// occluder boxes are rasterized into a low-resolution depth buffer
+// (Vulkan depth, 0 = near, 1 = far; nearest depth wins), a max-depth
+// hierarchical-Z pyramid is built from it, and every other primitive's
+// bounds are tested against the coarsest level that covers them with a
+// few texels. Everything runs on the CPU, four pixels at a time with SSE
+// where available. Only the tests use it so far: nothing feeds it the
+// scene's boxes or skips the draws it culls.
+class OcclusionCuller
+{
+public:
+    struct Stats {
+        int occludersRasterized = 0;
+        int occludersRejected = 0;   // Crossing the near plane or off screen
+        int tested = 0;
+        int culled = 0;
+    };
+
+    // Dimensions are rounded up to powers of two (minimum 4)
+    explicit OcclusionCuller(int width = 256, int height = 128);
+
+    // Clears the depth buffer for a new view
+    void beginFrame(const glm::mat4& viewProjection);
+
+    // Rasterizes up to `maxOccluders` boxes, largest projected area first
+    void rasterizeOccluders(const Aabb* boxes, int count, int maxOccluders);
+    void rasterizeOccluder(const Aabb& box);
+
+    // Rebuilds the HiZ pyramid; call after rasterizing and before testing
+    void buildHierarchy();
+
+    // Conservative: false only when the box is certainly hidden
+    bool isVisible(const Aabb& box);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int levelCount() const { return static_cast<int>(m_levels.size()); }
+    int levelWidth(int level) const { return std::max(1, m_width >> level); }
+    int levelHeight(int level) const { return std::max(1, m_height >> level); }
+    const float* depth(int level = 0) const { return m_levels[level].data(); }
+    const Stats& stats() const { return m_stats; }
+
+private:
+    struct ScreenBounds {
+        float minX, minY, maxX, maxY;
+        float minDepth, maxDepth;
+    };
+
+    // Projects the 8 corners; false if the box crosses the near plane
+    bool project(const Aabb& box, glm::vec3 corners[8], ScreenBounds& bounds) const;
+    void rasterizeTriangle(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2);
+    void downsample(int level);
+
+    int m_width;
+    int m_height;
+    glm::mat4 m_viewProjection{ 1.0f };
+    std::vector<std::vector<float>> m_levels;   // Level 0 = full-resolution depth
+    std::vector<std::pair<float, int>> m_ranking;
+    Stats m_stats;
+};
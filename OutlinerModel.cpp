@@ -0,0 +1,143 @@
+#include "OutlinerModel.h"
+
+// ===================================================================
+// == OutlinerModel Implementation
+// ===================================================================
+OutlinerModel::OutlinerModel(QObject* parent)
+    : QAbstractItemModel(parent)
+{
+}
+
+QModelIndex OutlinerModel::index(int row, int column, const QModelIndex& parent) const
+{
+    // Flat list: only the invisible root has children
+    if (parent.isValid() || column != 0 || row < 0 || row >= primitiveCount()) {
+        return QModelIndex();
+    }
+    return createIndex(row, column);
+}
+
+QModelIndex OutlinerModel::parent(const QModelIndex& /*child*/) const
+{
+    return QModelIndex();
+}
+
+int OutlinerModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : primitiveCount();
+}
+
+int OutlinerModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : 1;
+}
+
+QVariant OutlinerModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid()) return QVariant();
+
+    const int row = index.row();
+    switch (role) {
+    case Qt::DisplayRole:
+        return m_names[row];
+    case Qt::UserRole:
+        // Visibility lives in the custom role (true = visible), same as the eye delegate expects
+        return m_visible.test(row);
+    default:
+        return QVariant();
+    }
+}
+
+bool OutlinerModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (!index.isValid() || role != Qt::UserRole) return false;
+
+    const int row = index.row();
+    const bool visible = value.toBool();
+    if (m_visible.test(row) == visible) return true;
+
+    m_visible.set(row, visible);
+    emit dataChanged(index, index, { Qt::UserRole });
+    emit visibilityChanged(row, m_handles[row], visible);
+    return true;
+}
+
+Qt::ItemFlags OutlinerModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+
+    // No checkable flag: visibility is driven by the eye icon only
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+int OutlinerModel::appendPrimitive(PrimitiveHandle handle, const QString& name)
+{
+    const int row = primitiveCount();
+
+    beginInsertRows(QModelIndex(), row, row);
+    m_handles.push_back(handle);
+    m_names.append(name);
+    m_visible.resize(row + 1, true);
+    endInsertRows();
+
+    return row;
+}
+
+int OutlinerModel::appendPrimitives(const std::vector<PrimitiveHandle>& handles, const QString& name)
+{
+    const int first = primitiveCount();
+    if (handles.empty()) return first;
+
+    // One insert notification for the whole batch instead of one per row
+    const int count = static_cast<int>(handles.size());
+    beginInsertRows(QModelIndex(), first, first + count - 1);
+    m_handles.insert(m_handles.end(), handles.begin(), handles.end());
+    m_names.reserve(first + count);
+    for (int i = 0; i < count; ++i) {
+        m_names.append(name);
+    }
+    m_visible.resize(first + count, true);
+    endInsertRows();
+
+    return first;
+}
+
+void OutlinerModel::setVisibleRange(int firstRow, int count, bool visible)
+{
+    if (firstRow < 0 || count <= 0 || firstRow + count > primitiveCount()) return;
+
+    // Collect only the rows that flip, so the renderer is not asked to redo unchanged ones
+    QVector<PrimitiveHandle> changedHandles;
+    int firstChanged = -1;
+    int lastChanged = -1;
+    m_visible.forEachDiffering(firstRow, count, visible, [&](int row) {
+        changedHandles.append(m_handles[row]);
+        if (firstChanged < 0) firstChanged = row;
+        lastChanged = row;
+        });
+    if (changedHandles.isEmpty()) return;
+
+    m_visible.setRange(firstRow, count, visible);
+
+    emit dataChanged(index(firstChanged, 0), index(lastChanged, 0), { Qt::UserRole });
+    emit visibilityRangeChanged(changedHandles, visible);
+}
+
+void OutlinerModel::clear()
+{
+    takeAll();
+}
+
+QVector<QString> OutlinerModel::takeAll()
+{
+    QVector<QString> names;
+    if (m_handles.empty()) return names;
+
+    // Handles and visibility bits are plain data; only the names cost a destructor per row
+    beginResetModel();
+    m_handles.clear();
+    names.swap(m_names);
+    m_visible.clear();
+    endResetModel();
+    return names;
+}
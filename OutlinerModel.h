@@ -0,0 +1,61 @@
+#pragma once
+
+#include "SlotMap.h"
+#include "VisibilityMask.h"
+
+#include <QAbstractItemModel>
+#include <QString>
+#include <QVector>
+#include <vector>
+
+
+// ===================================================================
+// == OutlinerModel Declaration
+// ===================================================================
+// Flat, single-column model behind the outliner view. Every row is one
+// primitive; its handle, display name and visibility bit are kept
+// in parallel arrays so the view never owns per-row heap objects.
+class OutlinerModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    explicit OutlinerModel(QObject* parent = nullptr);
+
+    // QAbstractItemModel interface
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    // Scene-facing API
+    int appendPrimitive(PrimitiveHandle handle, const QString& name);
+    int appendPrimitives(const std::vector<PrimitiveHandle>& handles, const QString& name);
+    void clear();
+
+    // Removes every row like clear(), but hands the names back so the caller decides when they are destroyed
+    QVector<QString> takeAll();
+
+    int primitiveCount() const { return static_cast<int>(m_handles.size()); }
+    PrimitiveHandle primitiveHandle(int row) const { return m_handles[row]; }
+    bool isVisible(int row) const { return m_visible.test(row); }
+
+    // Bulk visibility: one dataChanged and one visibilityRangeChanged for the whole range
+    void setVisibleRange(int firstRow, int count, bool visible);
+    void setAllVisible(bool visible) { setVisibleRange(0, primitiveCount(), visible); }
+
+signals:
+    // Emitted when the eye toggle of a single row changes
+    void visibilityChanged(int row, PrimitiveHandle handle, bool visible);
+
+    // Emitted once per bulk update with the handles whose visibility actually changed
+    void visibilityRangeChanged(const QVector<PrimitiveHandle>& handles, bool visible);
+
+private:
+    std::vector<PrimitiveHandle> m_handles;
+    QVector<QString> m_names;
+    VisibilityMask m_visible;
+};
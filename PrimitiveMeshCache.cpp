@@ -0,0 +1,50 @@
+#include "PrimitiveMeshCache.h"
+
+// ===================================================================
+// == PrimitiveMeshCache Implementation
+// ===================================================================
+PrimitiveMeshCache::Handle PrimitiveMeshCache::acquire(int kind, const Generator& generate)
+{
+    ++m_requests;
+
+    auto it = m_entries.find(kind);
+    if (it != m_entries.end()) {
+        if (Handle mesh = it.value().lock()) {
+            ++m_hits;
+            return mesh;
+        }
+    }
+
+    Handle mesh = std::make_shared<const Mesh>(generate());
+    m_entries.insert(kind, mesh);
+    return mesh;
+}
+
+void PrimitiveMeshCache::purge()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it.value().expired()) {
+            it = m_entries.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+PrimitiveMeshCache::Stats PrimitiveMeshCache::stats() const
+{
+    Stats result;
+    result.requests = m_requests;
+    result.hits = m_hits;
+
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        const int instances = static_cast<int>(it.value().use_count());
+        if (instances == 0) continue;
+
+        ++result.uniqueMeshes;
+        result.liveInstances += instances;
+        result.reusedInstances += instances - 1;
+    }
+    return result;
+}
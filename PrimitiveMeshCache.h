@@ -0,0 +1,46 @@
+#pragma once
+
+#include "VPrimatives.h"
+
+#include <QHash>
+#include <QtGlobal>
+#include <functional>
+#include <memory>
+
+
+// ===================================================================
+// == PrimitiveMeshCache Declaration
+// ===================================================================
+// Shares one generated mesh between every object of the same primitive
+// kind, so a shape is only generated once. Meshes are handed out as
+// reference-counted handles and released when the last handle goes. This
+// is a CPU-side saving only: VulkanRenderer::addPrimitive() still copies
+// the mesh into its own vertex and index buffers for every object.
+class PrimitiveMeshCache
+{
+public:
+    using Mesh = decltype(VPrimatives::createCube());
+    using Handle = std::shared_ptr<const Mesh>;
+    using Generator = std::function<Mesh()>;
+
+    struct Stats {
+        int uniqueMeshes = 0;      // Meshes currently resident
+        int liveInstances = 0;     // Handles currently referring to them
+        int reusedInstances = 0;   // Live handles that skipped generation; the renderer still uploads each one
+        quint64 requests = 0;
+        quint64 hits = 0;
+    };
+
+    // Returns the cached mesh for primitive kind `kind`, running `generate` only on a miss
+    Handle acquire(int kind, const Generator& generate);
+
+    // Drops bookkeeping for meshes that no longer have any handles
+    void purge();
+
+    Stats stats() const;
+
+private:
+    QHash<int, std::weak_ptr<const Mesh>> m_entries;
+    quint64 m_requests = 0;
+    quint64 m_hits = 0;
+};
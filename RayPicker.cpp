@@ -0,0 +1,270 @@
+#include "RayPicker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef FLEURA_PICKING_SSE
+#include <emmintrin.h>
+#endif
+
+namespace {
+    constexpr float PICK_EPSILON = 1e-7f;
+
+    // Slab test; returns the entry distance or a negative value on a miss
+    float intersectBox(const Aabb& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance)
+    {
+        const glm::vec3 t0 = (box.min - origin) * inverseDirection;
+        const glm::vec3 t1 = (box.max - origin) * inverseDirection;
+        const glm::vec3 tNear = glm::min(t0, t1);
+        const glm::vec3 tFar = glm::max(t0, t1);
+
+        const float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+        return entry <= exit ? entry : -1.0f;
+    }
+}
+
+// ===================================================================
+// == Ray Implementation
+// ===================================================================
+Ray Ray::fromNdc(float ndcX, float ndcY, const glm::mat4& inverseViewProjection)
+{
+    glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, 0.0f, 1.0f);
+    glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+    nearPoint /= nearPoint.w;
+    farPoint /= farPoint.w;
+
+    Ray ray;
+    ray.origin = glm::vec3(nearPoint);
+    ray.direction = glm::normalize(glm::vec3(farPoint) - glm::vec3(nearPoint));
+    return ray;
+}
+
+// ===================================================================
+// == RayPicker Implementation
+// ===================================================================
+int RayPicker::addMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices)
+{
+    Mesh mesh;
+    mesh.triangleCount = static_cast<int>(indices.size() / 3);
+    mesh.bounds = Aabb::fromPoints(positions.data(), positions.size(), sizeof(glm::vec3));
+
+    // Pad the last packet with degenerate triangles; their determinant is zero so they never hit
+    mesh.packets.resize((mesh.triangleCount + 3) / 4);
+    for (TrianglePacket& packet : mesh.packets) {
+        std::fill(&packet.v0[0][0], &packet.v0[0][0] + 12, 0.0f);
+        std::fill(&packet.edge1[0][0], &packet.edge1[0][0] + 12, 0.0f);
+        std::fill(&packet.edge2[0][0], &packet.edge2[0][0] + 12, 0.0f);
+    }
+
+    for (int i = 0; i < mesh.triangleCount; ++i) {
+        const glm::vec3& a = positions[indices[i * 3]];
+        const glm::vec3 e1 = positions[indices[i * 3 + 1]] - a;
+        const glm::vec3 e2 = positions[indices[i * 3 + 2]] - a;
+
+        TrianglePacket& packet = mesh.packets[i / 4];
+        const int lane = i % 4;
+        for (int axis = 0; axis < 3; ++axis) {
+            packet.v0[axis][lane] = a[axis];
+            packet.edge1[axis][lane] = e1[axis];
+            packet.edge2[axis][lane] = e2[axis];
+        }
+    }
+
+    m_meshes.push_back(std::move(mesh));
+    return static_cast<int>(m_meshes.size()) - 1;
+}
+
+int RayPicker::addObject(int mesh, const glm::mat4& transform, int userData)
+{
+    Object object;
+    object.mesh = mesh;
+    object.userData = userData;
+    object.transform = transform;
+    object.inverseTransform = glm::inverse(transform);
+
+    const int index = static_cast<int>(m_objects.size());
+    object.proxy = m_bvh.insert(worldBounds(object), index);
+    m_objects.push_back(object);
+    return index;
+}
+
+void RayPicker::setTransform(int object, const glm::mat4& transform)
+{
+    Object& o = m_objects[object];
+    o.transform = transform;
+    o.inverseTransform = glm::inverse(transform);
+    if (o.proxy != DynamicBvh::NULL_NODE) {
+        m_bvh.update(o.proxy, worldBounds(o));
+    }
+}
+
+void RayPicker::setPickable(int object, bool pickable)
+{
+    Object& o = m_objects[object];
+    if (pickable == (o.proxy != DynamicBvh::NULL_NODE)) return;
+
+    if (pickable) {
+        o.proxy = m_bvh.insert(worldBounds(o), object);
+    }
+    else {
+        m_bvh.remove(o.proxy);
+        o.proxy = DynamicBvh::NULL_NODE;
+    }
+}
+
+void RayPicker::clearObjects()
+{
+    m_objects.clear();
+    m_bvh.clear();
+}
+
+Aabb RayPicker::worldBounds(const Object& object) const
+{
+    return m_meshes[object.mesh].bounds.transformed(object.transform);
+}
+
+RayPicker::Hit RayPicker::pick(const Ray& ray) const
+{
+    Hit hit;
+    if (m_bvh.root() == DynamicBvh::NULL_NODE) return hit;
+
+    const glm::vec3 inverseDirection = 1.0f / ray.direction;
+    float best = std::numeric_limits<float>::max();
+
+    // Nearest-first walk: the closer child is popped first, and anything
+    // whose entry point lies beyond the best hit so far is skipped
+    m_stack.clear();
+    m_stack.emplace_back(0.0f, m_bvh.root());
+    while (!m_stack.empty()) {
+        const std::pair<float, int> entry = m_stack.back();
+        m_stack.pop_back();
+        if (entry.first > best) continue;
+
+        const DynamicBvh::Node& node = m_bvh.node(entry.second);
+        if (node.isLeaf()) {
+            const Object& object = m_objects[node.userData];
+
+            // Affine transform keeps the ray parameter, so distances stay in world units
+            Ray local;
+            local.origin = glm::vec3(object.inverseTransform * glm::vec4(ray.origin, 1.0f));
+            local.direction = glm::vec3(object.inverseTransform * glm::vec4(ray.direction, 0.0f));
+
+            const int triangle = intersectMesh(m_meshes[object.mesh], local, best);
+            if (triangle >= 0) {
+                hit.object = node.userData;
+                hit.userData = object.userData;
+                hit.triangle = triangle;
+                hit.distance = best;
+            }
+            continue;
+        }
+
+        const float t1 = intersectBox(m_bvh.node(node.child1).box, ray.origin, inverseDirection, best);
+        const float t2 = intersectBox(m_bvh.node(node.child2).box, ray.origin, inverseDirection, best);
+        if (t1 >= 0.0f && t2 >= 0.0f) {
+            if (t1 < t2) {
+                m_stack.emplace_back(t2, node.child2);
+                m_stack.emplace_back(t1, node.child1);
+            }
+            else {
+                m_stack.emplace_back(t1, node.child1);
+                m_stack.emplace_back(t2, node.child2);
+            }
+        }
+        else if (t1 >= 0.0f) {
+            m_stack.emplace_back(t1, node.child1);
+        }
+        else if (t2 >= 0.0f) {
+            m_stack.emplace_back(t2, node.child2);
+        }
+    }
+    return hit;
+}
+
+int RayPicker::intersectMesh(const Mesh& mesh, const Ray& ray, float& maxDistance)
+{
+    // Moller-Trumbore, two-sided
+    int result = -1;
+
+#ifdef FLEURA_PICKING_SSE
+    const __m128 ox = _mm_set1_ps(ray.origin.x), oy = _mm_set1_ps(ray.origin.y), oz = _mm_set1_ps(ray.origin.z);
+    const __m128 dx = _mm_set1_ps(ray.direction.x), dy = _mm_set1_ps(ray.direction.y), dz = _mm_set1_ps(ray.direction.z);
+    const __m128 epsilon = _mm_set1_ps(PICK_EPSILON);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    for (size_t p = 0; p < mesh.packets.size(); ++p) {
+        const TrianglePacket& packet = mesh.packets[p];
+        const __m128 e1x = _mm_load_ps(packet.edge1[0]), e1y = _mm_load_ps(packet.edge1[1]), e1z = _mm_load_ps(packet.edge1[2]);
+        const __m128 e2x = _mm_load_ps(packet.edge2[0]), e2y = _mm_load_ps(packet.edge2[1]), e2z = _mm_load_ps(packet.edge2[2]);
+
+        // pvec = dir x edge2, det = edge1 . pvec
+        const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        __m128 mask = _mm_cmpgt_ps(_mm_andnot_ps(signMask, det), epsilon);
+        if (_mm_movemask_ps(mask) == 0) continue;
+        const __m128 invDet = _mm_div_ps(one, det);
+
+        const __m128 tx = _mm_sub_ps(ox, _mm_load_ps(packet.v0[0]));
+        const __m128 ty = _mm_sub_ps(oy, _mm_load_ps(packet.v0[1]));
+        const __m128 tz = _mm_sub_ps(oz, _mm_load_ps(packet.v0[2]));
+        const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet);
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+        if (_mm_movemask_ps(mask) == 0) continue;
+
+        // qvec = tvec x edge1
+        const __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+        const __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+        const __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+        const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+        const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpgt_ps(t, epsilon), _mm_cmplt_ps(t, _mm_set1_ps(maxDistance))));
+
+        int lanes = _mm_movemask_ps(mask);
+        if (lanes == 0) continue;
+
+        alignas(16) float distances[4];
+        _mm_store_ps(distances, t);
+        for (int lane = 0; lanes != 0; ++lane, lanes >>= 1) {
+            if ((lanes & 1) && distances[lane] < maxDistance) {
+                maxDistance = distances[lane];
+                result = static_cast<int>(p) * 4 + lane;
+            }
+        }
+    }
+#else
+    for (int i = 0; i < mesh.triangleCount; ++i) {
+        const TrianglePacket& packet = mesh.packets[i / 4];
+        const int lane = i % 4;
+        const glm::vec3 v0(packet.v0[0][lane], packet.v0[1][lane], packet.v0[2][lane]);
+        const glm::vec3 e1(packet.edge1[0][lane], packet.edge1[1][lane], packet.edge1[2][lane]);
+        const glm::vec3 e2(packet.edge2[0][lane], packet.edge2[1][lane], packet.edge2[2][lane]);
+
+        const glm::vec3 pvec = glm::cross(ray.direction, e2);
+        const float det = glm::dot(e1, pvec);
+        if (std::fabs(det) <= PICK_EPSILON) continue;
+        const float invDet = 1.0f / det;
+
+        const glm::vec3 tvec = ray.origin - v0;
+        const float u = glm::dot(tvec, pvec) * invDet;
+        if (u < 0.0f || u > 1.0f) continue;
+
+        const glm::vec3 qvec = glm::cross(tvec, e1);
+        const float v = glm::dot(ray.direction, qvec) * invDet;
+        if (v < 0.0f || u + v > 1.0f) continue;
+
+        const float t = glm::dot(e2, qvec) * invDet;
+        if (t > PICK_EPSILON && t < maxDistance) {
+            maxDistance = t;
+            result = i;
+        }
+    }
+#endif
+    return result;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Bounds.h"
+#include "DynamicBvh.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLEURA_PICKING_SSE 1
+#endif
+
+
+// ===================================================================
+// == Ray Declaration
+// ===================================================================
+struct Ray
+{
+    glm::vec3 origin{ 0.0f };
+    glm::vec3 direction{ 0.0f, 0.0f, -1.0f };
+
+    // Ray through a point in normalized device coordinates (Vulkan: x, y in [-1, 1], depth [0, 1])
+    static Ray fromNdc(float ndcX, float ndcY, const glm::mat4& inverseViewProjection);
+};
+
+
+// ===================================================================
+// == RayPicker Declaration
+// ===================================================================
+// CPU object picking. Objects are instances of shared meshes placed by a
+// world matrix; their world bounds live in a DynamicBvh that is walked
+// nearest-first, and only the leaves the ray actually reaches run the
+// exact ray/triangle test, four triangles at a time with SSE.
+class RayPicker
+{
+public:
+    struct Hit {
+        int object = -1;          // -1 = nothing hit
+        int userData = -1;
+        int triangle = -1;
+        float distance = 0.0f;    // Along the ray, in units of its direction vector
+
+        bool isValid() const { return object >= 0; }
+    };
+
+    // Registers triangle geometry shared by any number of objects; returns a mesh ID
+    int addMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+    int meshCount() const { return static_cast<int>(m_meshes.size()); }
+
+    // Objects are numbered in insertion order starting at 0
+    int addObject(int mesh, const glm::mat4& transform, int userData);
+    void setTransform(int object, const glm::mat4& transform);
+
+    // Unpickable objects (e.g. hidden ones) are taken out of the index
+    void setPickable(int object, bool pickable);
+
+    // Removes all objects; registered meshes are kept
+    void clearObjects();
+
+    int objectCount() const { return static_cast<int>(m_objects.size()); }
+
+    Hit pick(const Ray& ray) const;
+
+private:
+    // Four triangles in SoA form: vertex 0 and the two edges leaving it
+    struct TrianglePacket {
+        alignas(16) float v0[3][4];
+        alignas(16) float edge1[3][4];
+        alignas(16) float edge2[3][4];
+    };
+
+    struct Mesh {
+        std::vector<TrianglePacket> packets;
+        int triangleCount = 0;
+        Aabb bounds;
+    };
+
+    struct Object {
+        int mesh = -1;
+        int userData = -1;
+        int proxy = DynamicBvh::NULL_NODE;   // NULL_NODE while unpickable
+        glm::mat4 transform{ 1.0f };
+        glm::mat4 inverseTransform{ 1.0f };
+    };
+
+    Aabb worldBounds(const Object& object) const;
+
+    // Closest hit below `maxDistance` in object space; returns the triangle index or -1
+    static int intersectMesh(const Mesh& mesh, const Ray& ray, float& maxDistance);
+
+    std::vector<Mesh> m_meshes;
+    std::vector<Object> m_objects;
+    DynamicBvh m_bvh;
+    mutable std::vector<std::pair<float, int>> m_stack;
+};
@@ -0,0 +1,201 @@
+#include "SessionRecorder.h"
+
+#include <QTimer>
+
+namespace {
+    const quint32 SESSION_MAGIC = 0x464C5253;   // "FLRS"
+    const quint16 SESSION_VERSION = 1;
+}
+
+const char* SessionCommand::typeName(Type type)
+{
+    switch (type) {
+    case SpawnPrimitives: return "SpawnPrimitives";
+    case ClearScene:      return "ClearScene";
+    case SetTransform:    return "SetTransform";
+    case KeyState:        return "KeyState";
+    case SetVisibility:   return "SetVisibility";
+    case SetAllVisible:   return "SetAllVisible";
+    default:              return "Unknown";
+    }
+}
+
+// ===================================================================
+// == SessionRecorder Implementation
+// ===================================================================
+SessionRecorder::~SessionRecorder()
+{
+    stop();
+}
+
+bool SessionRecorder::start(const QString& filePath)
+{
+    stop();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+    m_stream.setDevice(&m_file);
+    m_stream.setByteOrder(QDataStream::LittleEndian);
+    m_stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    m_stream << SESSION_MAGIC << SESSION_VERSION;
+    m_clock.start();
+    return true;
+}
+
+void SessionRecorder::stop()
+{
+    if (!m_file.isOpen()) return;
+
+    m_stream.setDevice(nullptr);
+    m_file.close();
+}
+
+void SessionRecorder::record(SessionCommand command)
+{
+    if (!isRecording()) return;
+
+    command.timestampNs = m_clock.nsecsElapsed();
+
+    // Only the fields a command uses are written
+    m_stream << quint8(command.type) << command.timestampNs;
+    switch (command.type) {
+    case SessionCommand::SpawnPrimitives:
+    case SessionCommand::KeyState:
+    case SessionCommand::SetVisibility:
+        m_stream << command.a << command.b;
+        break;
+    case SessionCommand::SetTransform:
+        m_stream << command.a << command.b << command.vector.x << command.vector.y << command.vector.z;
+        break;
+    case SessionCommand::SetAllVisible:
+        m_stream << command.b;
+        break;
+    default:
+        break;
+    }
+}
+
+// ===================================================================
+// == SessionReplayer Implementation
+// ===================================================================
+SessionReplayer::SessionReplayer(QObject* parent)
+    : QObject(parent)
+{
+}
+
+bool SessionReplayer::load(const QString& filePath)
+{
+    m_commands.clear();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != SESSION_MAGIC || version != SESSION_VERSION) return false;
+
+    while (!stream.atEnd()) {
+        quint8 type = 0;
+        SessionCommand command;
+        stream >> type >> command.timestampNs;
+        if (type == 0 || type >= SessionCommand::TypeCount) return false;
+        command.type = SessionCommand::Type(type);
+
+        switch (command.type) {
+        case SessionCommand::SpawnPrimitives:
+        case SessionCommand::KeyState:
+        case SessionCommand::SetVisibility:
+            stream >> command.a >> command.b;
+            break;
+        case SessionCommand::SetTransform:
+            stream >> command.a >> command.b >> command.vector.x >> command.vector.y >> command.vector.z;
+            break;
+        case SessionCommand::SetAllVisible:
+            stream >> command.b;
+            break;
+        default:
+            break;
+        }
+
+        if (stream.status() != QDataStream::Ok) return false;
+        m_commands.append(command);
+    }
+    return true;
+}
+
+void SessionReplayer::replay(const Handler& handler, bool originalPace)
+{
+    m_handler = handler;
+    m_originalPace = originalPace;
+    m_timings = QVector<TypeTiming>(SessionCommand::TypeCount);
+    m_totalMs = 0.0;
+    m_next = 0;
+    m_clock.start();
+
+    if (originalPace) {
+        runNext();
+        return;
+    }
+
+    // Fast mode: back to back, no event loop round trips between commands
+    while (m_next >= 0) {
+        runNext();
+    }
+}
+
+void SessionReplayer::runNext()
+{
+    if (m_next < 0) return;
+    if (m_next >= m_commands.size()) {
+        m_totalMs = m_clock.nsecsElapsed() / 1e6;
+        m_next = -1;
+        emit finished();
+        return;
+    }
+
+    const SessionCommand& command = m_commands[m_next++];
+
+    QElapsedTimer timer;
+    timer.start();
+    m_handler(command);
+    const double elapsedMs = timer.nsecsElapsed() / 1e6;
+
+    TypeTiming& timing = m_timings[command.type];
+    ++timing.count;
+    timing.totalMs += elapsedMs;
+    timing.maxMs = qMax(timing.maxMs, elapsedMs);
+
+    if (!m_originalPace) return;
+
+    // Wait until the next command's original offset from the start of the session
+    qint64 delayMs = 0;
+    if (m_next < m_commands.size()) {
+        delayMs = (m_commands[m_next].timestampNs - m_clock.nsecsElapsed()) / 1000000;
+    }
+    QTimer::singleShot(qMax<qint64>(0, delayMs), Qt::PreciseTimer, this, &SessionReplayer::runNext);
+}
+
+QString SessionReplayer::report() const
+{
+    QStringList lines;
+    lines << QString("Replayed %1 commands in %2 ms").arg(m_commands.size()).arg(m_totalMs, 0, 'f', 2);
+
+    for (int type = 1; type < m_timings.size(); ++type) {
+        const TypeTiming& timing = m_timings[type];
+        if (timing.count == 0) continue;
+
+        lines << QString("%1: %2 x, total %3 ms, avg %4 ms, max %5 ms")
+            .arg(SessionCommand::typeName(SessionCommand::Type(type)))
+            .arg(timing.count)
+            .arg(timing.totalMs, 0, 'f', 3)
+            .arg(timing.totalMs / timing.count, 0, 'f', 3)
+            .arg(timing.maxMs, 0, 'f', 3);
+    }
+    return lines.join('\n');
+}
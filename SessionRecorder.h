@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QObject>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+#include <glm/glm.hpp>
+
+
+// ===================================================================
+// == SessionCommand
+// ===================================================================
+// One editor command as stored in a session log. Arguments are packed
+// into a small fixed set of fields; which ones are used depends on type.
+struct SessionCommand
+{
+    enum Type : quint8 {
+        SpawnPrimitives = 1,   // a = primitive kind, b = count
+        ClearScene,
+        SetTransform,          // a = transform type, b = outliner row (-1 = none selected), vector = values
+        KeyState,              // a = Qt key, b = pressed
+        SetVisibility,         // a = outliner row, b = visible
+        SetAllVisible,         // b = visible
+        TypeCount
+    };
+
+    Type type = SpawnPrimitives;
+    qint64 timestampNs = 0;    // Since recording started
+    qint32 a = 0;
+    qint32 b = 0;
+    glm::vec3 vector{ 0.0f };
+
+    static const char* typeName(Type type);
+};
+
+
+// ===================================================================
+// == SessionRecorder Declaration
+// ===================================================================
+// Appends editor commands with timestamps to a compact binary log.
+class SessionRecorder
+{
+public:
+    ~SessionRecorder();
+
+    bool start(const QString& filePath);
+    void stop();
+    bool isRecording() const { return m_file.isOpen(); }
+
+    void record(SessionCommand command);
+
+private:
+    QFile m_file;
+    QDataStream m_stream;
+    QElapsedTimer m_clock;
+};
+
+
+// ===================================================================
+// == SessionReplayer Declaration
+// ===================================================================
+// Re-runs a recorded log through a command handler, either as fast as
+// possible or at the original pace, and times every command by type.
+class SessionReplayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Handler = std::function<void(const SessionCommand&)>;
+
+    struct TypeTiming {
+        int count = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    explicit SessionReplayer(QObject* parent = nullptr);
+
+    bool load(const QString& filePath);
+    int commandCount() const { return m_commands.size(); }
+
+    // Starts replaying; finished() is emitted when the last command has run
+    void replay(const Handler& handler, bool originalPace);
+    bool isReplaying() const { return m_next >= 0; }
+
+    const QVector<TypeTiming>& timings() const { return m_timings; }
+    double totalMs() const { return m_totalMs; }
+    QString report() const;
+
+signals:
+    void finished();
+
+private:
+    void runNext();
+
+    QVector<SessionCommand> m_commands;
+    QVector<TypeTiming> m_timings;
+    Handler m_handler;
+    QElapsedTimer m_clock;
+    bool m_originalPace = false;
+    int m_next = -1;
+    double m_totalMs = 0.0;
+};
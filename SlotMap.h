@@ -0,0 +1,182 @@
+#pragma once
+
+#include <QHash>
+#include <QMetaType>
+#include <QtGlobal>
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+
+// ===================================================================
+// == PrimitiveHandle Declaration
+// ===================================================================
+// Slot index plus the generation the slot had when the handle was
+// issued. A slot's generation is bumped whenever its object goes away,
+// so a handle kept past removal (or past a clear) no longer resolves.
+struct PrimitiveHandle
+{
+    static constexpr quint32 INVALID_INDEX = 0xFFFFFFFFu;
+
+    quint32 index = INVALID_INDEX;
+    quint32 generation = 0;
+
+    bool isNull() const { return index == INVALID_INDEX; }
+
+    bool operator==(const PrimitiveHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const PrimitiveHandle& other) const { return !(*this == other); }
+};
+Q_DECLARE_METATYPE(PrimitiveHandle)
+
+inline uint qHash(const PrimitiveHandle& handle, uint seed = 0)
+{
+    return qHash((quint64(handle.generation) << 32) | handle.index, seed);
+}
+
+
+// ===================================================================
+// == SlotMap Declaration
+// ===================================================================
+// Generational slot map. Values are stored densely (removal swaps the
+// last value into the hole), so iterating live objects is a plain array
+// walk; handles resolve through a slot table in O(1) and stale handles
+// resolve to nullptr instead of aliasing a newer object. clear() drops
+// the slot table and starts new slots above every generation issued so
+// far, so it invalidates all handles without visiting them.
+template<typename T>
+class SlotMap
+{
+public:
+    PrimitiveHandle insert(T value);
+    bool remove(PrimitiveHandle handle);
+
+    // Invalidates every outstanding handle; O(1) apart from destroying the values
+    void clear();
+
+    T* get(PrimitiveHandle handle);
+    const T* get(PrimitiveHandle handle) const;
+    bool contains(PrimitiveHandle handle) const { return get(handle) != nullptr; }
+
+    int size() const { return static_cast<int>(m_values.size()); }
+    bool isEmpty() const { return m_values.empty(); }
+    void reserve(int count);
+
+    // Dense iteration over live values; handleAt() maps a dense position back to its handle
+    typename std::vector<T>::iterator begin() { return m_values.begin(); }
+    typename std::vector<T>::iterator end() { return m_values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return m_values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return m_values.end(); }
+    PrimitiveHandle handleAt(int dense) const;
+
+private:
+    struct Slot {
+        quint32 dense = 0;        // Position in m_values, or the next free slot while unused
+        quint32 generation = 0;
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<T> m_values;
+    std::vector<quint32> m_denseToSlot;
+    quint32 m_freeHead = PrimitiveHandle::INVALID_INDEX;
+    quint32 m_firstGeneration = 0;    // Generation of newly created slots
+    quint32 m_maxGeneration = 0;      // Highest generation any slot has had
+};
+
+template<typename T>
+PrimitiveHandle SlotMap<T>::insert(T value)
+{
+    quint32 slot;
+    if (m_freeHead != PrimitiveHandle::INVALID_INDEX) {
+        slot = m_freeHead;
+        m_freeHead = m_slots[slot].dense;
+    }
+    else {
+        slot = static_cast<quint32>(m_slots.size());
+        m_slots.emplace_back();
+        m_slots.back().generation = m_firstGeneration;
+    }
+
+    m_slots[slot].dense = static_cast<quint32>(m_values.size());
+    m_values.push_back(std::move(value));
+    m_denseToSlot.push_back(slot);
+
+    PrimitiveHandle handle;
+    handle.index = slot;
+    handle.generation = m_slots[slot].generation;
+    return handle;
+}
+
+template<typename T>
+bool SlotMap<T>::remove(PrimitiveHandle handle)
+{
+    if (!contains(handle)) return false;
+
+    // Move the last value into the hole so storage stays dense
+    const quint32 dense = m_slots[handle.index].dense;
+    const quint32 last = static_cast<quint32>(m_values.size()) - 1;
+    if (dense != last) {
+        m_values[dense] = std::move(m_values[last]);
+        m_denseToSlot[dense] = m_denseToSlot[last];
+        m_slots[m_denseToSlot[dense]].dense = dense;
+    }
+    m_values.pop_back();
+    m_denseToSlot.pop_back();
+
+    Slot& slot = m_slots[handle.index];
+    ++slot.generation;
+    m_maxGeneration = std::max(m_maxGeneration, slot.generation);
+    slot.dense = m_freeHead;
+    m_freeHead = handle.index;
+    return true;
+}
+
+template<typename T>
+void SlotMap<T>::clear()
+{
+    // Handles issued so far carry at most m_maxGeneration, so recreated slots can never match them
+    m_firstGeneration = m_maxGeneration + 1;
+    m_maxGeneration = m_firstGeneration;
+    m_slots.clear();
+    m_values.clear();
+    m_denseToSlot.clear();
+    m_freeHead = PrimitiveHandle::INVALID_INDEX;
+}
+
+template<typename T>
+T* SlotMap<T>::get(PrimitiveHandle handle)
+{
+    return const_cast<T*>(static_cast<const SlotMap*>(this)->get(handle));
+}
+
+template<typename T>
+const T* SlotMap<T>::get(PrimitiveHandle handle) const
+{
+    if (handle.index >= m_slots.size()) return nullptr;
+
+    const Slot& slot = m_slots[handle.index];
+    if (slot.generation != handle.generation) return nullptr;
+
+    // Free slots keep their bumped generation, so a matching one is always live
+    assert(slot.dense < m_values.size() && m_denseToSlot[slot.dense] == handle.index);
+    return &m_values[slot.dense];
+}
+
+template<typename T>
+void SlotMap<T>::reserve(int count)
+{
+    m_values.reserve(count);
+    m_denseToSlot.reserve(count);
+    m_slots.reserve(count);
+}
+
+template<typename T>
+PrimitiveHandle SlotMap<T>::handleAt(int dense) const
+{
+    PrimitiveHandle handle;
+    handle.index = m_denseToSlot[dense];
+    handle.generation = m_slots[handle.index].generation;
+    return handle;
+}
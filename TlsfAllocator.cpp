@@ -0,0 +1,227 @@
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+    quint64 alignUp(quint64 value, quint64 alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    int mostSignificantBit(quint64 value)
+    {
+        return 63 - static_cast<int>(qCountLeadingZeroBits(value));
+    }
+}
+
+// ===================================================================
+// == TlsfAllocator Implementation
+// ===================================================================
+TlsfAllocator::TlsfAllocator(quint64 size)
+{
+    reset(size);
+}
+
+void TlsfAllocator::reset(quint64 size)
+{
+    m_ranges.clear();
+    m_unusedRanges = NULL_RANGE;
+    std::fill(&m_heads[0][0], &m_heads[0][0] + FL_COUNT * SL_COUNT, NULL_RANGE);
+    std::fill(m_slBitmaps, m_slBitmaps + FL_COUNT, 0u);
+    m_flBitmap = 0;
+    m_size = size & ~(GRANULARITY - 1);
+    m_usedBytes = 0;
+    m_freeRangeCount = 0;
+    m_allocationCount = 0;
+
+    if (m_size == 0) return;
+
+    const int range = newRange();
+    m_ranges[range].offset = 0;
+    m_ranges[range].size = m_size;
+    insertFree(range);
+}
+
+void TlsfAllocator::mapping(quint64 size, int& fl, int& sl)
+{
+    // Sizes are multiples of GRANULARITY (16 = 1 << SL_BITS), so fl >= SL_BITS
+    fl = mostSignificantBit(size);
+    sl = static_cast<int>((size >> (fl - SL_BITS)) ^ SL_COUNT);
+}
+
+int TlsfAllocator::findFree(quint64 size) const
+{
+    // Round up to the next size class so any range found there is large enough
+    int fl = mostSignificantBit(size);
+    quint64 rounded = size + (quint64(1) << (fl - SL_BITS)) - 1;
+    int sl;
+    mapping(rounded, fl, sl);
+    if (fl >= FL_COUNT) return NULL_RANGE;
+
+    quint32 slMap = m_slBitmaps[fl] & (~0u << sl);
+    if (slMap == 0) {
+        const quint64 flMap = fl + 1 < 64 ? m_flBitmap & (~quint64(0) << (fl + 1)) : 0;
+        if (flMap == 0) return NULL_RANGE;
+        fl = static_cast<int>(qCountTrailingZeroBits(flMap));
+        slMap = m_slBitmaps[fl];
+    }
+    sl = static_cast<int>(qCountTrailingZeroBits(slMap));
+    return m_heads[fl][sl];
+}
+
+void TlsfAllocator::insertFree(int range)
+{
+    Range& r = m_ranges[range];
+    int fl, sl;
+    mapping(r.size, fl, sl);
+
+    r.free = true;
+    r.prevFree = NULL_RANGE;
+    r.nextFree = m_heads[fl][sl];
+    if (r.nextFree != NULL_RANGE) {
+        m_ranges[r.nextFree].prevFree = range;
+    }
+    m_heads[fl][sl] = range;
+    m_flBitmap |= quint64(1) << fl;
+    m_slBitmaps[fl] |= 1u << sl;
+    ++m_freeRangeCount;
+}
+
+void TlsfAllocator::removeFree(int range)
+{
+    Range& r = m_ranges[range];
+    int fl, sl;
+    mapping(r.size, fl, sl);
+
+    if (r.prevFree != NULL_RANGE) m_ranges[r.prevFree].nextFree = r.nextFree;
+    if (r.nextFree != NULL_RANGE) m_ranges[r.nextFree].prevFree = r.prevFree;
+    if (m_heads[fl][sl] == range) {
+        m_heads[fl][sl] = r.nextFree;
+        if (r.nextFree == NULL_RANGE) {
+            m_slBitmaps[fl] &= ~(1u << sl);
+            if (m_slBitmaps[fl] == 0) m_flBitmap &= ~(quint64(1) << fl);
+        }
+    }
+    r.free = false;
+    r.prevFree = r.nextFree = NULL_RANGE;
+    --m_freeRangeCount;
+}
+
+int TlsfAllocator::newRange()
+{
+    if (m_unusedRanges != NULL_RANGE) {
+        const int range = m_unusedRanges;
+        m_unusedRanges = m_ranges[range].prevFree;
+        m_ranges[range] = Range();
+        return range;
+    }
+    m_ranges.emplace_back();
+    return static_cast<int>(m_ranges.size()) - 1;
+}
+
+void TlsfAllocator::releaseRange(int range)
+{
+    m_ranges[range] = Range();
+    m_ranges[range].prevFree = m_unusedRanges;
+    m_unusedRanges = range;
+}
+
+int TlsfAllocator::split(int range, quint64 size)
+{
+    const int remainder = newRange();
+    Range& r = m_ranges[range];
+    Range& rest = m_ranges[remainder];
+
+    rest.offset = r.offset + size;
+    rest.size = r.size - size;
+    rest.prevPhysical = range;
+    rest.nextPhysical = r.nextPhysical;
+    if (rest.nextPhysical != NULL_RANGE) {
+        m_ranges[rest.nextPhysical].prevPhysical = remainder;
+    }
+    r.size = size;
+    r.nextPhysical = remainder;
+    return remainder;
+}
+
+void TlsfAllocator::mergeWithNext(int range)
+{
+    Range& r = m_ranges[range];
+    const int next = r.nextPhysical;
+    Range& n = m_ranges[next];
+
+    r.size += n.size;
+    r.nextPhysical = n.nextPhysical;
+    if (r.nextPhysical != NULL_RANGE) {
+        m_ranges[r.nextPhysical].prevPhysical = range;
+    }
+    releaseRange(next);
+}
+
+int TlsfAllocator::allocate(quint64 size, quint64 alignment)
+{
+    if (size == 0) return NULL_RANGE;
+
+    size = alignUp(size, GRANULARITY);
+    alignment = std::max(alignment, GRANULARITY);
+
+    // Over-aligned requests search for enough slack to slide the start forward
+    const quint64 searchSize = size + (alignment > GRANULARITY ? alignment - GRANULARITY : 0);
+    const int range = findFree(searchSize);
+    if (range == NULL_RANGE) return NULL_RANGE;
+
+    removeFree(range);
+    int allocated = range;
+
+    // Leading padding becomes its own free range
+    const quint64 padding = alignUp(m_ranges[range].offset, alignment) - m_ranges[range].offset;
+    if (padding > 0) {
+        allocated = split(range, padding);
+        insertFree(range);
+    }
+
+    if (m_ranges[allocated].size > size) {
+        insertFree(split(allocated, size));
+    }
+
+    m_usedBytes += size;
+    ++m_allocationCount;
+    return allocated;
+}
+
+void TlsfAllocator::free(int range)
+{
+    assert(range >= 0 && range < static_cast<int>(m_ranges.size()) && !m_ranges[range].free);
+
+    m_usedBytes -= m_ranges[range].size;
+    --m_allocationCount;
+
+    const int next = m_ranges[range].nextPhysical;
+    if (next != NULL_RANGE && m_ranges[next].free) {
+        removeFree(next);
+        mergeWithNext(range);
+    }
+
+    const int prev = m_ranges[range].prevPhysical;
+    if (prev != NULL_RANGE && m_ranges[prev].free) {
+        removeFree(prev);
+        mergeWithNext(prev);
+        range = prev;
+    }
+    insertFree(range);
+}
+
+quint64 TlsfAllocator::largestFreeRange() const
+{
+    if (m_flBitmap == 0) return 0;
+
+    // Only the highest non-empty bucket can hold the largest range
+    const int fl = mostSignificantBit(m_flBitmap);
+    const int sl = 31 - static_cast<int>(qCountLeadingZeroBits(m_slBitmaps[fl]));
+    quint64 largest = 0;
+    for (int range = m_heads[fl][sl]; range != NULL_RANGE; range = m_ranges[range].nextFree) {
+        largest = std::max(largest, m_ranges[range].size);
+    }
+    return largest;
+}
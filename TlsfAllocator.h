@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QtAlgorithms>
+#include <QtGlobal>
+#include <vector>
+
+
+// ===================================================================
+// == TlsfAllocator Declaration
+// ===================================================================
+// Two-level segregated fit allocator over the byte range of one memory
+// block. It only hands out offsets; the memory itself belongs to the
+// caller. Free ranges are bucketed by size class (power of two, split
+// into 16 linear steps), and two bitmaps locate a fitting bucket in
+// constant time. Neighbouring free ranges are merged on free.
+class TlsfAllocator
+{
+public:
+    static constexpr quint64 GRANULARITY = 16;   // Every range is a multiple of this
+    static constexpr int NULL_RANGE = -1;
+
+    explicit TlsfAllocator(quint64 size = 0);
+    void reset(quint64 size);
+
+    // Returns a range ID, or NULL_RANGE when no free range fits; `alignment` must be a power of two
+    int allocate(quint64 size, quint64 alignment = GRANULARITY);
+    void free(int range);
+
+    quint64 offset(int range) const { return m_ranges[range].offset; }
+    quint64 rangeSize(int range) const { return m_ranges[range].size; }
+
+    quint64 size() const { return m_size; }
+    quint64 usedBytes() const { return m_usedBytes; }
+    quint64 freeBytes() const { return m_size - m_usedBytes; }
+    quint64 largestFreeRange() const;
+    int freeRangeCount() const { return m_freeRangeCount; }
+    int allocationCount() const { return m_allocationCount; }
+    bool isEmpty() const { return m_allocationCount == 0; }
+
+private:
+    static constexpr int SL_BITS = 4;
+    static constexpr int SL_COUNT = 1 << SL_BITS;
+    static constexpr int FL_COUNT = 48;
+
+    struct Range {
+        quint64 offset = 0;
+        quint64 size = 0;
+        int prevPhysical = NULL_RANGE;
+        int nextPhysical = NULL_RANGE;
+        int prevFree = NULL_RANGE;   // Free-list links while free; prevFree doubles as the pool link when unused
+        int nextFree = NULL_RANGE;
+        bool free = false;
+    };
+
+    static void mapping(quint64 size, int& fl, int& sl);
+    int findFree(quint64 size) const;
+    void insertFree(int range);
+    void removeFree(int range);
+    int newRange();
+    void releaseRange(int range);
+    int split(int range, quint64 size);   // Keeps the front `size` bytes in `range`, returns the remainder
+    void mergeWithNext(int range);
+
+    std::vector<Range> m_ranges;
+    int m_unusedRanges = NULL_RANGE;
+    int m_heads[FL_COUNT][SL_COUNT];
+    quint64 m_flBitmap = 0;
+    quint32 m_slBitmaps[FL_COUNT];
+    quint64 m_size = 0;
+    quint64 m_usedBytes = 0;
+    int m_freeRangeCount = 0;
+    int m_allocationCount = 0;
+};
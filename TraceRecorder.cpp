@@ -0,0 +1,229 @@
+#include "TraceRecorder.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+
+std::atomic<bool> TraceRecorder::s_recording{ false };
+
+namespace {
+    // Event names are literals but thread names come from QObject::objectName(), so escape
+    // quotes, backslashes and control characters before they go into a JSON string
+    QByteArray jsonEscape(const char* text)
+    {
+        QByteArray escaped;
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') {
+                escaped += '\\';
+                escaped += *c;
+            }
+            else if (static_cast<unsigned char>(*c) < 0x20) {
+                escaped += QByteArray("\\u00") + QByteArray::number(static_cast<unsigned char>(*c), 16).rightJustified(2, '0');
+            }
+            else {
+                escaped += *c;
+            }
+        }
+        return escaped;
+    }
+}
+
+// ===================================================================
+// == TraceRecorder Implementation
+// ===================================================================
+TraceRecorder& TraceRecorder::instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+qint64 TraceRecorder::nowNs()
+{
+    using namespace std::chrono;
+    static const steady_clock::time_point origin = steady_clock::now();
+    return duration_cast<nanoseconds>(steady_clock::now() - origin).count();
+}
+
+void TraceRecorder::start()
+{
+    {
+        // Rings nobody owns only hold events of the previous recording
+        QMutexLocker locker(&m_registryMutex);
+        m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+            [](const std::unique_ptr<ThreadBuffer>& buffer) { return !buffer->inUse; }), m_buffers.end());
+        m_threadNames.erase(std::remove_if(m_threadNames.begin(), m_threadNames.end(),
+            [this](const std::pair<int, QString>& entry) {
+                return std::none_of(m_buffers.begin(), m_buffers.end(),
+                    [&](const std::unique_ptr<ThreadBuffer>& buffer) { return buffer->threadId == entry.first; });
+            }), m_threadNames.end());
+    }
+
+    // Old events are dropped lazily: each buffer resets when it sees the new generation
+    m_dropped.store(0, std::memory_order_relaxed);
+    ++m_generation;
+    s_recording.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::stop()
+{
+    // Sequentially consistent, paired with the writing flag in record()
+    s_recording.store(false);
+}
+
+TraceRecorder::BufferLease::~BufferLease()
+{
+    if (!buffer) return;
+
+    TraceRecorder& recorder = TraceRecorder::instance();
+    QMutexLocker locker(&recorder.m_registryMutex);
+    buffer->inUse = false;
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::currentBuffer()
+{
+    thread_local BufferLease lease;
+    if (lease.buffer) return lease.buffer;
+
+    // Threads turned away stay untraced until the next recording
+    const quint64 generation = m_generation.load(std::memory_order_relaxed);
+    if (lease.deniedGeneration == generation) return nullptr;
+
+    QMutexLocker locker(&m_registryMutex);
+    ThreadBuffer* buffer = nullptr;
+    for (const auto& candidate : m_buffers) {
+        if (!candidate->inUse) {
+            buffer = candidate.get();
+            break;
+        }
+    }
+    if (!buffer) {
+        if (static_cast<int>(m_buffers.size()) >= MAX_THREAD_BUFFERS) {
+            lease.deniedGeneration = generation;
+            return nullptr;
+        }
+        m_buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = m_buffers.back().get();
+    }
+    buffer->inUse = true;
+    buffer->threadId = ++m_nextThreadId;
+    lease.buffer = buffer;
+
+    QString threadName;
+    QThread* thread = QThread::currentThread();
+    if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+        threadName = "GUI";
+    }
+    else if (thread && !thread->objectName().isEmpty()) {
+        threadName = thread->objectName();
+    }
+    else {
+        threadName = QString("Worker %1").arg(buffer->threadId);
+    }
+    m_threadNames.emplace_back(buffer->threadId, threadName);
+    return buffer;
+}
+
+void TraceRecorder::record(const char* category, const char* name, qint64 startNs, qint64 durationNs)
+{
+    if (!isRecording()) return;
+
+    ThreadBuffer* buffer = currentBuffer();
+    if (!buffer) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Announce the write before re-checking the flag; writeChromeTrace() stores the flag and then
+    // waits for this one, so either we see the stop or the export waits for us
+    buffer->writing.store(true);
+    if (!s_recording.load()) {
+        buffer->writing.store(false, std::memory_order_release);
+        return;
+    }
+
+    const quint64 generation = m_generation.load(std::memory_order_relaxed);
+    if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+        buffer->written.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_relaxed);
+    }
+
+    const quint64 index = buffer->written.load(std::memory_order_relaxed);
+    buffer->events[index % EVENTS_PER_THREAD] = { category, name, startNs, durationNs, buffer->threadId };
+    buffer->written.store(index + 1, std::memory_order_release);
+    buffer->writing.store(false, std::memory_order_release);
+}
+
+bool TraceRecorder::writeChromeTrace(const QString& filePath)
+{
+    stop();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+    QMutexLocker locker(&m_registryMutex);
+    for (const auto& buffer : m_buffers) {
+        while (buffer->writing.load()) {
+            QThread::yieldCurrentThread();
+        }
+    }
+
+    const quint64 generation = m_generation.load(std::memory_order_relaxed);
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QByteArray out;
+    out.reserve(1 << 20);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+
+    // Thread name metadata so Perfetto labels the tracks
+    for (const auto& thread : m_threadNames) {
+        out += first ? "" : ",\n";
+        first = false;
+        out += QString("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%1,\"tid\":%2,\"args\":{\"name\":\"")
+            .arg(pid).arg(thread.first).toUtf8();
+        out += jsonEscape(thread.second.toUtf8().constData());
+        out += "\"}}";
+    }
+
+    auto flush = [&]() {
+        if (out.size() < (1 << 20)) return true;
+        const bool ok = file.write(out) == out.size();
+        out.clear();
+        return ok;
+        };
+
+    for (const auto& buffer : m_buffers) {
+        if (buffer->generation.load(std::memory_order_relaxed) != generation) continue;
+
+        const quint64 written = buffer->written.load(std::memory_order_acquire);
+        const quint64 begin = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+        for (quint64 i = begin; i < written; ++i) {
+            const Event& event = buffer->events[i % EVENTS_PER_THREAD];
+
+            // Chrome trace timestamps are microseconds
+            out += first ? "" : ",\n";
+            first = false;
+            out += "{\"ph\":\"X\",\"cat\":\"";
+            out += jsonEscape(event.category);
+            out += "\",\"name\":\"";
+            out += jsonEscape(event.name);
+            out += "\",\"pid\":";
+            out += QByteArray::number(pid);
+            out += ",\"tid\":";
+            out += QByteArray::number(event.threadId);
+            out += ",\"ts\":";
+            out += QByteArray::number(event.startNs / 1000.0, 'f', 3);
+            out += ",\"dur\":";
+            out += QByteArray::number(event.durationNs / 1000.0, 'f', 3);
+            out += "}";
+
+            if (!flush()) return false;
+        }
+    }
+
+    out += "\n]}\n";
+    return file.write(out) == out.size();
+}
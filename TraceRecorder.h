@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QMutex>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+// ===================================================================
+// == TraceRecorder Declaration
+// ===================================================================
+// Lightweight event tracing for editor and render work. Every thread
+// writes complete ("X") events into its own fixed-size ring, so
+// recording takes no locks; the newest events win once a ring wraps.
+// A ring goes back to the pool when its thread exits and the next new
+// thread keeps appending to it (events carry their thread id), so
+// short-lived pool threads do not each keep 4 MB. At most
+// MAX_THREAD_BUFFERS threads record at once; others are not traced.
+// writeChromeTrace() dumps all rings as Chrome trace JSON, which opens
+// directly in Perfetto or chrome://tracing.
+class TraceRecorder
+{
+public:
+    static constexpr quint32 EVENTS_PER_THREAD = 1u << 17;  // ~4 MB per thread
+    static constexpr int MAX_THREAD_BUFFERS = 32;
+
+    static TraceRecorder& instance();
+
+    static bool isRecording() { return s_recording.load(std::memory_order_relaxed); }
+    static qint64 nowNs();
+
+    // Clears previous events, frees rings no live thread owns and starts recording
+    void start();
+    void stop();
+
+    // Stops recording if needed, waits for events being written and writes every buffered
+    // event; false on I/O error. Scopes still open at that point are not recorded.
+    bool writeChromeTrace(const QString& filePath);
+
+    // Events lost in this recording because their thread found no free ring
+    quint64 droppedEvents() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // `category` and `name` must be string literals
+    void record(const char* category, const char* name, qint64 startNs, qint64 durationNs);
+
+private:
+    TraceRecorder() = default;
+
+    struct Event {
+        const char* category;
+        const char* name;
+        qint64 startNs;
+        qint64 durationNs;
+        int threadId;
+    };
+
+    struct ThreadBuffer {
+        int threadId = 0;                     // Current owner
+        std::unique_ptr<Event[]> events{ new Event[EVENTS_PER_THREAD] };
+        std::atomic<quint64> written{ 0 };    // Only the owning thread writes
+        std::atomic<quint64> generation{ 0 }; // Bumped by start() to invalidate old events
+        std::atomic<bool> writing{ false };   // Owner is inside record()
+        bool inUse = true;                    // Owned by a live thread; guarded by the registry mutex
+    };
+
+    // Returns the ring to the pool when its thread exits
+    struct BufferLease {
+        ThreadBuffer* buffer = nullptr;
+        quint64 deniedGeneration = ~quint64(0);   // No ring was free during this recording
+        ~BufferLease();
+    };
+
+    ThreadBuffer* currentBuffer();
+
+    static std::atomic<bool> s_recording;
+    QMutex m_registryMutex;   // Only taken when a thread records for the first time
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::vector<std::pair<int, QString>> m_threadNames;   // Every owner since start(), for the track labels
+    std::atomic<quint64> m_generation{ 0 };
+    std::atomic<quint64> m_dropped{ 0 };
+    int m_nextThreadId = 0;
+};
+
+
+// ===================================================================
+// == TraceScope Declaration
+// ===================================================================
+class TraceScope
+{
+public:
+    TraceScope(const char* category, const char* name)
+        : m_category(TraceRecorder::isRecording() ? category : nullptr)
+        , m_name(name)
+        , m_startNs(m_category ? TraceRecorder::nowNs() : 0)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_category) {
+            TraceRecorder::instance().record(m_category, m_name, m_startNs, TraceRecorder::nowNs() - m_startNs);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    qint64 m_startNs;
+};
+
+#define FLEURA_TRACE_CONCAT_INNER(a, b) a##b
+#define FLEURA_TRACE_CONCAT(a, b) FLEURA_TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(category, name) TraceScope FLEURA_TRACE_CONCAT(traceScope_, __LINE__)(category, name)
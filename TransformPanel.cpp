@@ -0,0 +1,116 @@
+#include "TransformPanel.h"
+
+#include "FrameProfiler.h"
+#include "TraceRecorder.h"
+
+#include <QDoubleSpinBox>
+#include <QSignalBlocker>
+#include <QTimer>
+#include <cmath>
+
+// ===================================================================
+// == TransformPanel Implementation
+// ===================================================================
+TransformPanel::TransformPanel(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void TransformPanel::setSpinBoxes(Channel channel, QDoubleSpinBox* x, QDoubleSpinBox* y, QDoubleSpinBox* z)
+{
+    m_spinBoxes[channel] = { x, y, z };
+    for (QDoubleSpinBox* spin : m_spinBoxes[channel]) {
+        connect(spin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [this, channel]() {
+            commit(channel);
+            });
+    }
+}
+
+void TransformPanel::setValues(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale)
+{
+    TRACE_SCOPE("ui", "updateTransformPanel");
+
+    // Compare at the box's precision. Signals are blocked per box so showing a value is not an edit.
+    auto setIfChanged = [](QDoubleSpinBox* spin, double value) {
+        if (!spin) return;
+        const double precision = std::pow(10.0, spin->decimals());
+        if (std::round(spin->value() * precision) == std::round(value * precision)) return;
+
+        QSignalBlocker blocker(spin);
+        spin->setValue(value);
+        };
+
+    const glm::vec3* shown[ChannelCount] = { &position, &rotation, &scale };
+    for (int channel = Translate; channel < ChannelCount; ++channel) {
+        for (int axis = 0; axis < 3; ++axis) {
+            setIfChanged(m_spinBoxes[channel][axis], (*shown[channel])[axis]);
+        }
+    }
+}
+
+glm::vec3 TransformPanel::values(Channel channel) const
+{
+    glm::vec3 result(0.0f);
+    for (int axis = 0; axis < 3; ++axis) {
+        if (m_spinBoxes[channel][axis]) {
+            result[axis] = float(m_spinBoxes[channel][axis]->value());
+        }
+    }
+    return result;
+}
+
+void TransformPanel::commit(Channel channel)
+{
+    queueEdit(m_primitive, channel, values(channel));
+}
+
+void TransformPanel::queueEdit(PrimitiveHandle primitive, Channel channel, const glm::vec3& values)
+{
+    ++m_editsQueued;
+
+    // Later edits of the same channel overwrite earlier ones until the flush
+    PendingEdit& edit = m_pending[primitive];
+    edit.channels |= quint8(1u << channel);
+    edit.values[channel] = values;
+
+    if (!m_flushTimer) {
+        m_flushTimer = new QTimer(this);
+        m_flushTimer->setSingleShot(true);
+        m_flushTimer->setTimerType(Qt::PreciseTimer);
+        connect(m_flushTimer, &QTimer::timeout, this, &TransformPanel::flush);
+    }
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start(m_flushInterval);
+    }
+}
+
+bool TransformPanel::flush()
+{
+    PROFILE_SCOPE("editor.transformEdits");
+    TRACE_SCOPE("ui", "flushTransformEdits");
+    if (m_flushTimer) {
+        m_flushTimer->stop();
+    }
+    if (m_pending.isEmpty()) return false;
+
+    // Take the batch first: listeners may queue new edits while we emit
+    const QHash<PrimitiveHandle, PendingEdit> pending = std::move(m_pending);
+    m_pending.clear();
+
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        for (int channel = Translate; channel < ChannelCount; ++channel) {
+            if (it.value().channels & (1u << channel)) {
+                emit transformEdited(it.key(), Channel(channel), it.value().values[channel]);
+            }
+        }
+    }
+    return true;
+}
+
+void TransformPanel::discardEdits()
+{
+    if (m_flushTimer) {
+        m_flushTimer->stop();
+    }
+    m_pending.clear();
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "SlotMap.h"
+
+#include <QHash>
+#include <QObject>
+#include <array>
+
+#include <glm/glm.hpp>
+
+class QDoubleSpinBox;
+class QTimer;
+
+
+// ===================================================================
+// == TransformPanel Declaration
+// ===================================================================
+// Logic behind the Transform section of the properties panel, kept out
+// of VulkanWidget so it can be linked and benchmarked on its own.
+// setValues() shows a primitive's transform without producing edits;
+// spin-box changes are queued per primitive, merged (last value per
+// channel wins) and delivered through transformEdited() once per flush
+// interval, so dragging a spin box costs one update per display frame.
+class TransformPanel : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Channel { Translate, Rotate, Scale, ChannelCount };
+    Q_ENUM(Channel)
+
+    explicit TransformPanel(QObject* parent = nullptr);
+
+    // The X/Y/Z boxes of one channel; their value changes become edits of primitive()
+    void setSpinBoxes(Channel channel, QDoubleSpinBox* x, QDoubleSpinBox* y, QDoubleSpinBox* z);
+
+    // Primitive the spin boxes edit; null when nothing is selected
+    void setPrimitive(PrimitiveHandle primitive) { m_primitive = primitive; }
+    PrimitiveHandle primitive() const { return m_primitive; }
+
+    // Shows a transform without queuing edits; only boxes whose displayed value changes are touched
+    void setValues(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale);
+    glm::vec3 values(Channel channel) const;
+
+    // Queues the values currently shown for `channel` as an edit of primitive()
+    void commit(Channel channel);
+    void queueEdit(PrimitiveHandle primitive, Channel channel, const glm::vec3& values);
+
+    // How long edits are merged before they are delivered (one display frame)
+    void setFlushInterval(int milliseconds) { m_flushInterval = qMax(1, milliseconds); }
+
+    // Delivers every pending edit now; returns false if there were none
+    bool flush();
+    void discardEdits();
+
+    // Edits received, before merging
+    quint64 editsQueued() const { return m_editsQueued; }
+
+signals:
+    void transformEdited(PrimitiveHandle primitive, TransformPanel::Channel channel, const glm::vec3& values);
+
+private:
+    struct PendingEdit {
+        quint8 channels = 0;                             // Bit per Channel holding a value
+        std::array<glm::vec3, ChannelCount> values{};    // Indexed by Channel
+    };
+
+    std::array<std::array<QDoubleSpinBox*, 3>, ChannelCount> m_spinBoxes{};
+    PrimitiveHandle m_primitive;
+    QHash<PrimitiveHandle, PendingEdit> m_pending;
+    QTimer* m_flushTimer = nullptr;
+    int m_flushInterval = 16;
+    quint64 m_editsQueued = 0;
+};
@@ -0,0 +1,253 @@
+#include "TransformStore.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FLEURA_TRANSFORM_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLEURA_TRANSFORM_SSE 1
+#endif
+
+namespace {
+    constexpr int PADDING = 8;
+
+    // Lane abstractions; the matrix kernel below is written once against them
+    struct ScalarLanes {
+        static constexpr int WIDTH = 1;
+        using Type = float;
+        static Type set(float v) { return v; }
+        static Type load(const float* p) { return *p; }
+        static void store(float* p, Type v) { *p = v; }
+        static Type add(Type a, Type b) { return a + b; }
+        static Type sub(Type a, Type b) { return a - b; }
+        static Type mul(Type a, Type b) { return a * b; }
+        static Type min(Type a, Type b) { return std::min(a, b); }
+        static Type max(Type a, Type b) { return std::max(a, b); }
+        static Type round(Type v) { return static_cast<float>(static_cast<int>(v < 0.0f ? v - 0.5f : v + 0.5f)); }
+    };
+
+#ifdef FLEURA_TRANSFORM_AVX
+    struct SimdLanes {
+        static constexpr int WIDTH = 8;
+        using Type = __m256;
+        static Type set(float v) { return _mm256_set1_ps(v); }
+        static Type load(const float* p) { return _mm256_loadu_ps(p); }
+        static void store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+        static Type add(Type a, Type b) { return _mm256_add_ps(a, b); }
+        static Type sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+        static Type mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+        static Type min(Type a, Type b) { return _mm256_min_ps(a, b); }
+        static Type max(Type a, Type b) { return _mm256_max_ps(a, b); }
+        static Type round(Type v) { return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    };
+#elif defined(FLEURA_TRANSFORM_SSE)
+    struct SimdLanes {
+        static constexpr int WIDTH = 4;
+        using Type = __m128;
+        static Type set(float v) { return _mm_set1_ps(v); }
+        static Type load(const float* p) { return _mm_loadu_ps(p); }
+        static void store(float* p, Type v) { _mm_storeu_ps(p, v); }
+        static Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+        static Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+        static Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+        static Type min(Type a, Type b) { return _mm_min_ps(a, b); }
+        static Type max(Type a, Type b) { return _mm_max_ps(a, b); }
+        static Type round(Type v) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(v)); }   // SSE2 has no roundps
+    };
+#else
+    using SimdLanes = ScalarLanes;
+#endif
+
+    // sin(x) for radians; accurate to ~1e-7 over the editor's angle range
+    template<typename L>
+    typename L::Type sine(typename L::Type x)
+    {
+        // Reduce to [-pi, pi], splitting 2*pi so the subtraction stays exact
+        const typename L::Type turns = L::round(L::mul(x, L::set(0.159154943f)));
+        x = L::sub(L::sub(x, L::mul(turns, L::set(6.28125f))), L::mul(turns, L::set(0.00193530717f)));
+
+        // Fold to [-pi/2, pi/2] using sin(x) = sin(pi - x)
+        const typename L::Type pi = L::set(3.14159265f);
+        x = L::max(L::min(x, L::sub(pi, x)), L::sub(L::set(-3.14159265f), x));
+
+        // Taylor series up to x^11
+        const typename L::Type x2 = L::mul(x, x);
+        typename L::Type p = L::set(-2.50521084e-8f);
+        p = L::add(L::mul(p, x2), L::set(2.75573192e-6f));
+        p = L::add(L::mul(p, x2), L::set(-1.98412698e-4f));
+        p = L::add(L::mul(p, x2), L::set(8.33333333e-3f));
+        p = L::add(L::mul(p, x2), L::set(-1.66666667e-1f));
+        p = L::add(L::mul(p, x2), L::set(1.0f));
+        return L::mul(p, x);
+    }
+
+    // Builds the world matrices of WIDTH consecutive objects into out[16][WIDTH]
+    template<typename L>
+    void buildMatrices(const std::vector<float>* channels, int first, float* out)
+    {
+        using V = typename L::Type;
+        const V toRadians = L::set(0.0174532925f);
+        const V quarterTurn = L::set(1.57079633f);
+
+        const V ax = L::mul(L::load(channels[TransformStore::RotationX].data() + first), toRadians);
+        const V ay = L::mul(L::load(channels[TransformStore::RotationY].data() + first), toRadians);
+        const V az = L::mul(L::load(channels[TransformStore::RotationZ].data() + first), toRadians);
+        const V sx = sine<L>(ax), cx = sine<L>(L::add(ax, quarterTurn));
+        const V sy = sine<L>(ay), cy = sine<L>(L::add(ay, quarterTurn));
+        const V sz = sine<L>(az), cz = sine<L>(L::add(az, quarterTurn));
+
+        const V scaleX = L::load(channels[TransformStore::ScaleX].data() + first);
+        const V scaleY = L::load(channels[TransformStore::ScaleY].data() + first);
+        const V scaleZ = L::load(channels[TransformStore::ScaleZ].data() + first);
+
+        // Rz * Ry * Rx, column by column, each column scaled by its axis
+        const V szsy = L::mul(sz, sy);
+        const V czsy = L::mul(cz, sy);
+        const int w = L::WIDTH;
+
+        L::store(out + 0 * w, L::mul(L::mul(cy, cz), scaleX));
+        L::store(out + 1 * w, L::mul(L::mul(cy, sz), scaleX));
+        L::store(out + 2 * w, L::mul(L::sub(L::set(0.0f), sy), scaleX));
+        L::store(out + 3 * w, L::set(0.0f));
+
+        L::store(out + 4 * w, L::mul(L::sub(L::mul(czsy, sx), L::mul(sz, cx)), scaleY));
+        L::store(out + 5 * w, L::mul(L::add(L::mul(szsy, sx), L::mul(cz, cx)), scaleY));
+        L::store(out + 6 * w, L::mul(L::mul(cy, sx), scaleY));
+        L::store(out + 7 * w, L::set(0.0f));
+
+        L::store(out + 8 * w, L::mul(L::add(L::mul(czsy, cx), L::mul(sz, sx)), scaleZ));
+        L::store(out + 9 * w, L::mul(L::sub(L::mul(szsy, cx), L::mul(cz, sx)), scaleZ));
+        L::store(out + 10 * w, L::mul(L::mul(cy, cx), scaleZ));
+        L::store(out + 11 * w, L::set(0.0f));
+
+        L::store(out + 12 * w, L::load(channels[TransformStore::PositionX].data() + first));
+        L::store(out + 13 * w, L::load(channels[TransformStore::PositionY].data() + first));
+        L::store(out + 14 * w, L::load(channels[TransformStore::PositionZ].data() + first));
+        L::store(out + 15 * w, L::set(1.0f));
+    }
+}
+
+// ===================================================================
+// == TransformStore Implementation
+// ===================================================================
+int TransformStore::add(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale)
+{
+    const int index = m_size++;
+    const size_t padded = size_t(m_size + PADDING - 1) & ~size_t(PADDING - 1);
+    if (m_channels[0].size() < padded) {
+        for (int channel = 0; channel < ChannelCount; ++channel) {
+            m_channels[channel].resize(padded, channel >= ScaleX ? 1.0f : 0.0f);
+        }
+    }
+    m_dirty.resize((m_size + 63) / 64, 0);
+
+    m_channels[PositionX][index] = position.x;
+    m_channels[PositionY][index] = position.y;
+    m_channels[PositionZ][index] = position.z;
+    m_channels[RotationX][index] = rotation.x;
+    m_channels[RotationY][index] = rotation.y;
+    m_channels[RotationZ][index] = rotation.z;
+    m_channels[ScaleX][index] = scale.x;
+    m_channels[ScaleY][index] = scale.y;
+    m_channels[ScaleZ][index] = scale.z;
+    markDirty(index);
+    return index;
+}
+
+void TransformStore::clear()
+{
+    for (auto& channel : m_channels) {
+        channel.clear();
+    }
+    m_dirty.clear();
+    m_size = 0;
+    m_flushedBegin = m_flushedEnd = 0;
+}
+
+void TransformStore::markDirtyRange(int first, int count)
+{
+    const int last = std::min(first + count, m_size);
+    for (int index = std::max(first, 0); index < last; ) {
+        // Whole words at once where the range covers them
+        if ((index & 63) == 0 && index + 64 <= last) {
+            m_dirty[index >> 6] = ~quint64(0);
+            index += 64;
+        }
+        else {
+            markDirty(index++);
+        }
+    }
+}
+
+int TransformStore::dirtyCount() const
+{
+    int count = 0;
+    for (quint64 word : m_dirty) {
+        count += qPopulationCount(word);
+    }
+    return count;
+}
+
+glm::mat4 TransformStore::worldMatrix(int index) const
+{
+    // Same kernel as flush(), one lane wide, so both paths share one formula
+    float columns[16];
+    buildMatrices<ScalarLanes>(m_channels, index, columns);
+
+    glm::mat4 matrix;
+    for (int column = 0; column < 4; ++column) {
+        matrix[column] = glm::vec4(columns[column * 4], columns[column * 4 + 1], columns[column * 4 + 2], columns[column * 4 + 3]);
+    }
+    return matrix;
+}
+
+int TransformStore::flush(void* destination, size_t stride)
+{
+    constexpr int WIDTH = SimdLanes::WIDTH;
+    constexpr quint64 BLOCK_MASK = (quint64(1) << WIDTH) - 1;
+    alignas(32) float block[16 * WIDTH];
+    char* base = static_cast<char*>(destination);
+
+    int written = 0;
+    m_flushedBegin = m_size;
+    m_flushedEnd = 0;
+
+    for (size_t word = 0; word < m_dirty.size(); ++word) {
+        quint64 bits = m_dirty[word];
+        if (bits == 0) continue;
+        m_dirty[word] = 0;
+
+        while (bits) {
+            // Rebuild the whole SIMD block holding the lowest dirty bit, then scatter its dirty lanes
+            const int blockStart = static_cast<int>(qCountTrailingZeroBits(bits)) & ~(WIDTH - 1);
+            const int first = static_cast<int>(word) * 64 + blockStart;
+            quint64 lanes = (bits >> blockStart) & BLOCK_MASK;
+            bits &= ~(BLOCK_MASK << blockStart);
+
+            buildMatrices<SimdLanes>(m_channels, first, block);
+
+            while (lanes) {
+                const int lane = static_cast<int>(qCountTrailingZeroBits(lanes));
+                lanes &= lanes - 1;
+
+                float matrix[16];
+                for (int element = 0; element < 16; ++element) {
+                    matrix[element] = block[element * WIDTH + lane];
+                }
+                std::memcpy(base + size_t(first + lane) * stride, matrix, sizeof(matrix));
+
+                m_flushedBegin = std::min(m_flushedBegin, first + lane);
+                m_flushedEnd = first + lane + 1;
+                ++written;
+            }
+        }
+    }
+
+    if (written == 0) {
+        m_flushedBegin = m_flushedEnd = 0;
+    }
+    return written;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QtAlgorithms>
+#include <QtGlobal>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+
+
+// ===================================================================
+// == TransformStore Declaration
+// ===================================================================
+// Object transforms in structure-of-arrays form: one float array per
+// component of position, rotation (Euler degrees) and scale, plus one
+// dirty bit per object. flush() rebuilds only the dirty world matrices
+// and writes them straight into a mapped buffer: four objects at a time
+// with SSE2, or eight when the translation unit is compiled with AVX
+// enabled (-mavx, /arch:AVX). AVX is opt-in per build; without it the
+// SSE2 path is used.
+//
+// World matrix = translate * rotateZ * rotateY * rotateX * scale.
+//
+// The editor does not call flush() yet: VulkanRenderer still takes
+// transforms through VulkanWidget::transformValuesChanged and has no
+// per-object matrix buffer to flush into. The editor keeps the store as
+// the source of truth for the transform panel and the picker.
+class TransformStore
+{
+public:
+    enum Channel {
+        PositionX, PositionY, PositionZ,
+        RotationX, RotationY, RotationZ,
+        ScaleX, ScaleY, ScaleZ,
+        ChannelCount
+    };
+
+    // Returns the new object's index (insertion order)
+    int add(const glm::vec3& position = glm::vec3(0.0f), const glm::vec3& rotation = glm::vec3(0.0f),
+        const glm::vec3& scale = glm::vec3(1.0f));
+    void clear();
+
+    int size() const { return m_size; }
+
+    void setPosition(int index, const glm::vec3& position) { store(PositionX, index, position); }
+    void setRotation(int index, const glm::vec3& degrees) { store(RotationX, index, degrees); }
+    void setScale(int index, const glm::vec3& scale) { store(ScaleX, index, scale); }
+
+    glm::vec3 position(int index) const { return load(PositionX, index); }
+    glm::vec3 rotation(int index) const { return load(RotationX, index); }
+    glm::vec3 scale(int index) const { return load(ScaleX, index); }
+
+    // Raw component arrays for bulk animation; mark what was written with markDirtyRange()
+    float* data(Channel channel) { return m_channels[channel].data(); }
+    const float* data(Channel channel) const { return m_channels[channel].data(); }
+
+    void markDirty(int index) { m_dirty[index >> 6] |= quint64(1) << (index & 63); }
+    void markDirtyRange(int first, int count);
+    void markAllDirty() { markDirtyRange(0, m_size); }
+    bool isDirty(int index) const { return (m_dirty[index >> 6] >> (index & 63)) & 1u; }
+    int dirtyCount() const;
+
+    glm::mat4 worldMatrix(int index) const;
+
+    // Writes the world matrix of every dirty object to destination + index * stride
+    // (column-major mat4) and clears the dirty bits. Returns how many were written;
+    // [flushedBegin(), flushedEnd()) bounds them for non-coherent memory flushes.
+    int flush(void* destination, size_t stride = sizeof(glm::mat4));
+    int flushedBegin() const { return m_flushedBegin; }
+    int flushedEnd() const { return m_flushedEnd; }
+
+private:
+    void store(Channel first, int index, const glm::vec3& value) {
+        m_channels[first][index] = value.x;
+        m_channels[first + 1][index] = value.y;
+        m_channels[first + 2][index] = value.z;
+        markDirty(index);
+    }
+    glm::vec3 load(Channel first, int index) const {
+        return glm::vec3(m_channels[first][index], m_channels[first + 1][index], m_channels[first + 2][index]);
+    }
+
+    // Arrays are padded to a multiple of 8 entries so full-width loads never run past the end
+    std::vector<float> m_channels[ChannelCount];
+    std::vector<quint64> m_dirty;
+    int m_size = 0;
+    int m_flushedBegin = 0;
+    int m_flushedEnd = 0;
+};
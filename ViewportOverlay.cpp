@@ -0,0 +1,179 @@
+#include "ViewportOverlay.h"
+
+#include <QEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QWindow>
+
+// ===================================================================
+// == ViewportOverlay Implementation
+// ===================================================================
+ViewportOverlay::ViewportOverlay(QObject* parent)
+    : QObject(parent)
+{
+}
+
+int ViewportOverlay::addButton(const QString& label)
+{
+    Button button;
+    button.label = label;
+    m_buttons.append(button);
+
+    relayout();
+    return m_buttons.size() - 1;
+}
+
+void ViewportOverlay::setViewportSize(const QSize& size)
+{
+    if (size == m_viewportSize) return;
+
+    m_viewportSize = size;
+    relayout();
+}
+
+int ViewportOverlay::hitTest(const QPoint& pos) const
+{
+    if (!m_imageRect.contains(pos)) return -1;
+
+    for (int i = 0; i < m_buttons.size(); ++i) {
+        if (m_buttons[i].rect.contains(pos)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool ViewportOverlay::consumeDirty()
+{
+    const bool dirty = m_dirty;
+    m_dirty = false;
+    return dirty;
+}
+
+bool ViewportOverlay::eventFilter(QObject* watched, QEvent* event)
+{
+    switch (event->type()) {
+    case QEvent::Resize:
+    case QEvent::Expose:
+        if (auto* window = qobject_cast<QWindow*>(watched)) {
+            if (!qFuzzyCompare(window->devicePixelRatio(), m_devicePixelRatio)) {
+                m_devicePixelRatio = window->devicePixelRatio();
+                m_viewportSize = QSize();
+            }
+            setViewportSize(window->size());
+        }
+        break;
+
+    case QEvent::MouseMove: {
+        auto* mouseEvent = static_cast<QMouseEvent*>(event);
+        setHovered(hitTest(mouseEvent->pos()));
+        // Let camera controls see moves unless a button is being pressed
+        return m_pressed >= 0;
+    }
+
+    case QEvent::MouseButtonPress: {
+        auto* mouseEvent = static_cast<QMouseEvent*>(event);
+        const int hit = hitTest(mouseEvent->pos());
+        if (hit < 0 || mouseEvent->button() != Qt::LeftButton) break;
+
+        m_pressed = hit;
+        repaint();
+        return true;
+    }
+
+    case QEvent::MouseButtonRelease: {
+        if (m_pressed < 0) break;
+
+        auto* mouseEvent = static_cast<QMouseEvent*>(event);
+        const int pressed = m_pressed;
+        m_pressed = -1;
+        repaint();
+
+        if (hitTest(mouseEvent->pos()) == pressed) {
+            emit buttonClicked(pressed);
+        }
+        return true;
+    }
+
+    case QEvent::Leave:
+        setHovered(-1);
+        break;
+
+    default:
+        break;
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+void ViewportOverlay::relayout()
+{
+    // Same placement as the widget overlay: a column pinned to the top-right corner
+    const int columnHeight = m_buttons.size() * (BUTTON_HEIGHT + SPACING) - SPACING;
+    const int x = m_viewportSize.width() - BUTTON_WIDTH - SPACING;
+    m_imageRect = m_buttons.isEmpty() ? QRect() : QRect(x, TOP_MARGIN, BUTTON_WIDTH, columnHeight);
+
+    for (int i = 0; i < m_buttons.size(); ++i) {
+        m_buttons[i].rect = QRect(x, TOP_MARGIN + i * (BUTTON_HEIGHT + SPACING), BUTTON_WIDTH, BUTTON_HEIGHT);
+    }
+
+    repaint();
+}
+
+void ViewportOverlay::repaint()
+{
+    if (m_imageRect.isEmpty()) {
+        m_image = QImage();
+        m_dirty = true;
+        emit changed();
+        return;
+    }
+
+    const QSize pixelSize = m_imageRect.size() * m_devicePixelRatio;
+    if (m_image.size() != pixelSize) {
+        m_image = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+    }
+    m_image.setDevicePixelRatio(m_devicePixelRatio);
+    m_image.fill(Qt::transparent);
+
+    QPainter painter(&m_image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.translate(-m_imageRect.topLeft());
+
+    // Colours match the widget overlay stylesheet
+    for (int i = 0; i < m_buttons.size(); ++i) {
+        const Button& button = m_buttons[i];
+
+        QColor fill("#393E46");
+        QColor border("#222222");
+        if (i == m_pressed) {
+            fill = QColor("#2C3138");
+        }
+        else if (i == m_hovered) {
+            fill = QColor("#4E5862");
+            border = QColor("#5c5c5c");
+        }
+
+        QPainterPath path;
+        path.addRoundedRect(QRectF(button.rect).adjusted(0.5, 0.5, -0.5, -0.5), 5, 5);
+        painter.fillPath(path, fill);
+        painter.setPen(QPen(border, 1));
+        painter.drawPath(path);
+
+        painter.setPen(Qt::white);
+        painter.drawText(button.rect, Qt::AlignCenter, button.label);
+    }
+    painter.end();
+
+    m_dirty = true;
+    emit changed();
+}
+
+void ViewportOverlay::setHovered(int index)
+{
+    if (index == m_hovered) return;
+
+    m_hovered = index;
+    repaint();
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QObject>
+#include <QImage>
+#include <QRect>
+#include <QString>
+#include <QVector>
+
+class QEvent;
+
+
+// ===================================================================
+// == ViewportOverlay Declaration
+// ===================================================================
+// In-frame replacement for the floating overlay tool window. The buttons
+// are laid out in viewport coordinates and painted into one small image
+// that the renderer composites on top of the scene; mouse hit-testing is
+// done by installing this object as an event filter on the Vulkan window.
+class ViewportOverlay : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ViewportOverlay(QObject* parent = nullptr);
+
+    int addButton(const QString& label);
+    void setViewportSize(const QSize& size);
+
+    // Index of the button under `pos` (viewport coordinates), or -1
+    int hitTest(const QPoint& pos) const;
+
+    // Premultiplied ARGB image of the button column and where it goes in the viewport
+    const QImage& image() const { return m_image; }
+    QRect imageRect() const { return m_imageRect; }
+
+    // True once after every repaint, so the renderer only re-uploads when needed
+    bool consumeDirty();
+
+signals:
+    void buttonClicked(int index);
+    void changed();
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    void relayout();
+    void repaint();
+    void setHovered(int index);
+
+    static constexpr int BUTTON_WIDTH = 120;
+    static constexpr int BUTTON_HEIGHT = 40;
+    static constexpr int SPACING = 10;
+    static constexpr int TOP_MARGIN = 10;
+
+    struct Button {
+        QString label;
+        QRect rect;   // Viewport coordinates
+    };
+
+    QVector<Button> m_buttons;
+    QSize m_viewportSize;
+    QRect m_imageRect;
+    QImage m_image;
+    qreal m_devicePixelRatio = 1.0;
+    int m_hovered = -1;
+    int m_pressed = -1;
+    bool m_dirty = false;
+};
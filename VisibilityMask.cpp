@@ -0,0 +1,70 @@
+#include "VisibilityMask.h"
+
+// ===================================================================
+// == VisibilityMask Implementation
+// ===================================================================
+void VisibilityMask::resize(int size, bool visible)
+{
+    const int oldSize = m_size;
+    m_size = size;
+    m_words.resize((size + 63) / 64, 0);
+
+    if (size > oldSize) {
+        setRange(oldSize, size - oldSize, visible);
+    }
+    else if (size & 63) {
+        // Keep the bits past the end zeroed so count() stays exact
+        m_words.back() &= (quint64(1) << (size & 63)) - 1;
+    }
+}
+
+void VisibilityMask::clear()
+{
+    m_words.clear();
+    m_size = 0;
+}
+
+void VisibilityMask::set(int index, bool visible)
+{
+    const quint64 bit = quint64(1) << (index & 63);
+    if (visible) {
+        m_words[index >> 6] |= bit;
+    }
+    else {
+        m_words[index >> 6] &= ~bit;
+    }
+}
+
+int VisibilityMask::setRange(int first, int count, bool visible)
+{
+    if (count <= 0) return 0;
+
+    int changed = 0;
+    const int last = first + count - 1;
+    for (int word = first >> 6; word <= (last >> 6); ++word) {
+        const quint64 mask = rangeMask(word, first, last);
+        const quint64 before = m_words[word];
+        const quint64 after = visible ? (before | mask) : (before & ~mask);
+        changed += static_cast<int>(qPopulationCount(before ^ after));
+        m_words[word] = after;
+    }
+    return changed;
+}
+
+int VisibilityMask::count() const
+{
+    int visible = 0;
+    for (quint64 word : m_words) {
+        visible += static_cast<int>(qPopulationCount(word));
+    }
+    return visible;
+}
+
+quint64 VisibilityMask::rangeMask(int word, int first, int last)
+{
+    // Bits of `word` that fall inside [first, last]
+    const int lo = (word << 6) > first ? 0 : first & 63;
+    const int hi = ((word << 6) + 63) < last ? 63 : last & 63;
+    const quint64 upper = hi == 63 ? ~quint64(0) : (quint64(1) << (hi + 1)) - 1;
+    return upper & ~((quint64(1) << lo) - 1);
+}
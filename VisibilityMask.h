@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QtAlgorithms>
+#include <QtGlobal>
+#include <vector>
+
+
+// ===================================================================
+// == VisibilityMask Declaration
+// ===================================================================
+// Packed visibility bits (1 = visible), 64 objects per word. Range
+// updates touch whole words, so showing or hiding a million objects is a
+// few thousand stores instead of a million individual calls.
+class VisibilityMask
+{
+public:
+    int size() const { return m_size; }
+    void resize(int size, bool visible);
+    void clear();
+
+    bool test(int index) const {
+        return (m_words[index >> 6] >> (index & 63)) & 1u;
+    }
+    void set(int index, bool visible);
+
+    // Sets [first, first + count) and returns how many bits actually changed
+    int setRange(int first, int count, bool visible);
+
+    // Number of visible objects
+    int count() const;
+
+    // Calls fn(index) for every index in [first, first + count) whose bit differs from `visible`
+    template<typename Fn>
+    void forEachDiffering(int first, int count, bool visible, Fn fn) const;
+
+private:
+    static quint64 rangeMask(int word, int first, int last);
+
+    std::vector<quint64> m_words;
+    int m_size = 0;
+};
+
+template<typename Fn>
+void VisibilityMask::forEachDiffering(int first, int count, bool visible, Fn fn) const
+{
+    if (count <= 0) return;
+
+    const int last = first + count - 1;
+    for (int word = first >> 6; word <= (last >> 6); ++word) {
+        quint64 bits = visible ? ~m_words[word] : m_words[word];
+        bits &= rangeMask(word, first, last);
+        while (bits) {
+            const int bit = static_cast<int>(qCountTrailingZeroBits(bits));
+            fn((word << 6) + bit);
+            bits &= bits - 1;
+        }
+    }
+}
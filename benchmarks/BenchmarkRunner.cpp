@@ -0,0 +1,73 @@
+#include "BenchmarkRunner.h"
+
+#include <QJsonObject>
+#include <QTextStream>
+#include <algorithm>
+#include <vector>
+
+// ===================================================================
+// == BenchmarkRunner Implementation
+// ===================================================================
+BenchmarkRunner::BenchmarkRunner(int repeats, const QStringList& filters)
+    : m_repeats(std::max(1, repeats))
+    , m_filters(filters)
+{
+}
+
+bool BenchmarkRunner::isSelected(const QString& name) const
+{
+    if (m_filters.isEmpty()) return true;
+    for (const QString& filter : m_filters) {
+        if (name.contains(filter)) return true;
+    }
+    return false;
+}
+
+void BenchmarkRunner::run(const QString& name, qint64 items, const Body& body)
+{
+    if (!isSelected(name)) return;
+
+    std::vector<qint64> samples;
+    samples.reserve(m_repeats);
+    for (int repeat = 0; repeat < m_repeats; ++repeat) {
+        Stopwatch stopwatch;
+        stopwatch.restart();
+        body(stopwatch);
+        stopwatch.stop();
+        samples.push_back(stopwatch.elapsed());
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const qint64 median = samples[samples.size() / 2];
+    qint64 total = 0;
+    for (qint64 sample : samples) total += sample;
+
+    QJsonObject result;
+    result.insert(QStringLiteral("name"), name);
+    result.insert(QStringLiteral("items"), double(items));
+    result.insert(QStringLiteral("repeats"), m_repeats);
+    result.insert(QStringLiteral("minNs"), double(samples.front()));
+    result.insert(QStringLiteral("medianNs"), double(median));
+    result.insert(QStringLiteral("meanNs"), double(total) / samples.size());
+    if (items > 0) {
+        result.insert(QStringLiteral("medianNsPerItem"), double(median) / items);
+    }
+    m_results.append(result);
+
+    // Progress goes to stderr so stdout can carry the JSON report
+    QTextStream(stderr) << name << ": " << QString::number(median / 1e6, 'f', 3) << " ms"
+        << (items > 0 ? QStringLiteral(" (%1 ns/item)").arg(double(median) / items, 0, 'f', 1) : QString())
+        << '\n';
+}
+
+std::vector<PrimitiveHandle> makeHandles(int count)
+{
+    SlotMap<int> slots;
+    slots.reserve(count);
+    std::vector<PrimitiveHandle> handles;
+    handles.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        handles.push_back(slots.insert(i));
+    }
+    return handles;
+}
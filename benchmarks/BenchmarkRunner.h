@@ -0,0 +1,65 @@
+#pragma once
+
+#include "SlotMap.h"
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include <vector>
+
+
+// ===================================================================
+// == BenchmarkRunner Declaration
+// ===================================================================
+// Minimal harness for the editor's CPU hot paths. Each benchmark body
+// runs `repeats` times; the body does its own setup, then calls
+// Stopwatch::restart() so only the measured work is timed. Results are
+// collected as JSON (one object per benchmark with min/median/mean
+// nanoseconds and the per-item median) for tracking regressions.
+class BenchmarkRunner
+{
+public:
+    class Stopwatch
+    {
+    public:
+        void restart() { m_stopped = false; m_timer.start(); }
+        void stop() { if (!m_stopped) { m_elapsed = m_timer.nsecsElapsed(); m_stopped = true; } }
+        qint64 elapsed() const { return m_elapsed; }
+
+    private:
+        QElapsedTimer m_timer;
+        qint64 m_elapsed = 0;
+        bool m_stopped = true;
+    };
+
+    using Body = std::function<void(Stopwatch&)>;
+
+    BenchmarkRunner(int repeats, const QStringList& filters);
+
+    // `items` is the amount of work one run does (rows, operations, rays); 0 skips the per-item figure
+    void run(const QString& name, qint64 items, const Body& body);
+
+    // Folds a result into a sink the optimizer cannot remove
+    void consume(quint64 value) { m_sink = m_sink + value; }
+
+    QJsonArray results() const { return m_results; }
+
+private:
+    bool isSelected(const QString& name) const;
+
+    int m_repeats;
+    QStringList m_filters;
+    QJsonArray m_results;
+    volatile quint64 m_sink = 0;
+};
+
+// `count` distinct live handles from one SlotMap, as the editor hands them to the outliner
+std::vector<PrimitiveHandle> makeHandles(int count);
+
+// Suites, one per translation unit
+void runCoreBenchmarks(BenchmarkRunner& runner);
+void runOutlinerBenchmarks(BenchmarkRunner& runner);
+void runDelegateBenchmarks(BenchmarkRunner& runner);
+void runTransformPanelBenchmarks(BenchmarkRunner& runner);
@@ -0,0 +1,311 @@
+#include "BenchmarkRunner.h"
+
+#include "DynamicBvh.h"
+#include "OutlinerModel.h"
+#include "RayPicker.h"
+#include "SlotMap.h"
+#include "TlsfAllocator.h"
+#include "TransformStore.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    const int OUTLINER_SIZES[] = { 1000, 100000, 1000000 };
+
+    Aabb randomBox(std::mt19937& rng, float range)
+    {
+        std::uniform_real_distribution<float> position(-range, range);
+        const glm::vec3 center(position(rng), position(rng), position(rng));
+        return { center - glm::vec3(1.0f), center + glm::vec3(1.0f) };
+    }
+
+    glm::mat4 viewProjection()
+    {
+        return glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f)
+            * glm::lookAt(glm::vec3(0.0f, -300.0f, 100.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+
+    void outlinerBenchmarks(BenchmarkRunner& runner)
+    {
+        for (int count : OUTLINER_SIZES) {
+            const std::vector<PrimitiveHandle> handles = makeHandles(count);
+            const QString suffix = QStringLiteral("/%1").arg(count);
+
+            runner.run(QStringLiteral("outliner/appendPrimitives") + suffix, count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+                OutlinerModel model;
+                stopwatch.restart();
+                model.appendPrimitives(handles, QStringLiteral("Cube"));
+                stopwatch.stop();
+                runner.consume(model.primitiveCount());
+                });
+
+            runner.run(QStringLiteral("outliner/appendPrimitive") + suffix, count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+                OutlinerModel model;
+                const QString name = QStringLiteral("Cube");
+                stopwatch.restart();
+                for (const PrimitiveHandle& handle : handles) {
+                    model.appendPrimitive(handle, name);
+                }
+                stopwatch.stop();
+                runner.consume(model.primitiveCount());
+                });
+
+            runner.run(QStringLiteral("outliner/clear") + suffix, count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+                OutlinerModel model;
+                model.appendPrimitives(handles, QStringLiteral("Cube"));
+                stopwatch.restart();
+                model.clear();
+                stopwatch.stop();
+                });
+
+            runner.run(QStringLiteral("outliner/data") + suffix, count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+                OutlinerModel model;
+                model.appendPrimitives(handles, QStringLiteral("Cube"));
+                stopwatch.restart();
+                for (int row = 0; row < count; ++row) {
+                    const QModelIndex index = model.index(row, 0);
+                    runner.consume(model.data(index, Qt::DisplayRole).toString().size());
+                    runner.consume(model.data(index, Qt::UserRole).toBool());
+                }
+                stopwatch.stop();
+                });
+
+            runner.run(QStringLiteral("outliner/setAllVisible") + suffix, count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+                OutlinerModel model;
+                model.appendPrimitives(handles, QStringLiteral("Cube"));
+                stopwatch.restart();
+                model.setAllVisible(false);
+                model.setAllVisible(true);
+                stopwatch.stop();
+                });
+        }
+    }
+
+    void slotMapBenchmarks(BenchmarkRunner& runner)
+    {
+        const int count = 1000000;
+
+        runner.run(QStringLiteral("slotMap/insert/1000000"), count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            SlotMap<int> slots;
+            stopwatch.restart();
+            for (int i = 0; i < count; ++i) {
+                slots.insert(i);
+            }
+            stopwatch.stop();
+            runner.consume(slots.size());
+            });
+
+        runner.run(QStringLiteral("slotMap/get/1000000"), count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            SlotMap<int> slots;
+            std::vector<PrimitiveHandle> handles;
+            handles.reserve(count);
+            for (int i = 0; i < count; ++i) handles.push_back(slots.insert(i));
+            std::shuffle(handles.begin(), handles.end(), std::mt19937(1));
+
+            stopwatch.restart();
+            quint64 sum = 0;
+            for (const PrimitiveHandle& handle : handles) {
+                sum += *slots.get(handle);
+            }
+            stopwatch.stop();
+            runner.consume(sum);
+            });
+
+        runner.run(QStringLiteral("slotMap/removeInsert/1000000"), count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            SlotMap<int> slots;
+            std::vector<PrimitiveHandle> handles;
+            handles.reserve(count);
+            for (int i = 0; i < count; ++i) handles.push_back(slots.insert(i));
+            std::shuffle(handles.begin(), handles.end(), std::mt19937(2));
+
+            // Remove half in random order, then refill through the free list
+            stopwatch.restart();
+            for (int i = 0; i < count / 2; ++i) {
+                slots.remove(handles[i]);
+            }
+            for (int i = 0; i < count / 2; ++i) {
+                slots.insert(i);
+            }
+            stopwatch.stop();
+            runner.consume(slots.size());
+            });
+
+        runner.run(QStringLiteral("slotMap/clear/1000000"), count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            SlotMap<int> slots;
+            for (int i = 0; i < count; ++i) slots.insert(i);
+            stopwatch.restart();
+            slots.clear();
+            });
+    }
+
+    void tlsfBenchmarks(BenchmarkRunner& runner)
+    {
+        const int operations = 1000000;
+
+        runner.run(QStringLiteral("tlsf/allocateFree/1000000"), operations, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            TlsfAllocator allocator(256ull * 1024 * 1024);
+            std::mt19937 rng(3);
+            std::vector<int> live;
+            live.reserve(4096);
+
+            // Steady state of mixed mesh-sized requests, like streaming vertex/index buffers
+            stopwatch.restart();
+            for (int i = 0; i < operations; ++i) {
+                if (live.size() < 4096 && (live.empty() || rng() % 2 == 0)) {
+                    const int range = allocator.allocate(64 + rng() % 65536, quint64(16) << (rng() % 5));
+                    if (range != TlsfAllocator::NULL_RANGE) live.push_back(range);
+                }
+                else {
+                    const size_t victim = rng() % live.size();
+                    allocator.free(live[victim]);
+                    live[victim] = live.back();
+                    live.pop_back();
+                }
+            }
+            stopwatch.stop();
+            runner.consume(allocator.usedBytes());
+            });
+    }
+
+    void bvhBenchmarks(BenchmarkRunner& runner)
+    {
+        const int count = 1000000;
+        std::mt19937 rng(4);
+        std::vector<Aabb> boxes;
+        boxes.reserve(count);
+        for (int i = 0; i < count; ++i) boxes.push_back(randomBox(rng, 250.0f));
+
+        runner.run(QStringLiteral("bvh/insert/1000000"), count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            DynamicBvh bvh;
+            stopwatch.restart();
+            for (int i = 0; i < count; ++i) {
+                bvh.insert(boxes[i], i);
+            }
+            stopwatch.stop();
+            runner.consume(bvh.height());
+            });
+
+        runner.run(QStringLiteral("bvh/update/1000000"), count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            DynamicBvh bvh;
+            std::vector<int> proxies;
+            proxies.reserve(count);
+            for (int i = 0; i < count; ++i) proxies.push_back(bvh.insert(boxes[i], i));
+
+            // Every object moves far enough to leave its fat box
+            const glm::vec3 offset(0.5f, 0.0f, 0.0f);
+            stopwatch.restart();
+            for (int i = 0; i < count; ++i) {
+                bvh.update(proxies[i], { boxes[i].min + offset, boxes[i].max + offset });
+            }
+            stopwatch.stop();
+            runner.consume(bvh.height());
+            });
+
+        DynamicBvh bvh;
+        for (int i = 0; i < count; ++i) bvh.insert(boxes[i], i);
+        const Frustum frustum(viewProjection());
+
+        runner.run(QStringLiteral("bvh/frustumQuery/1000000"), count, [&](BenchmarkRunner::Stopwatch&) {
+            quint64 visible = 0;
+            bvh.query(frustum, [&](int) { ++visible; });
+            runner.consume(visible);
+            });
+
+        runner.run(QStringLiteral("bvh/frustumBruteForce/1000000"), count, [&](BenchmarkRunner::Stopwatch&) {
+            quint64 visible = 0;
+            for (const Aabb& box : boxes) {
+                if (frustum.intersects(box)) ++visible;
+            }
+            runner.consume(visible);
+            });
+    }
+
+    void transformStoreBenchmarks(BenchmarkRunner& runner)
+    {
+        const int count = 100000;
+        TransformStore store;
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+        for (int i = 0; i < count; ++i) {
+            store.add(glm::vec3(value(rng), value(rng), value(rng)), glm::vec3(value(rng), value(rng), value(rng)), glm::vec3(1.0f));
+        }
+        std::vector<glm::mat4> matrices(count);
+
+        runner.run(QStringLiteral("transformStore/flushAll/100000"), count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            store.markAllDirty();
+            stopwatch.restart();
+            runner.consume(store.flush(matrices.data()));
+            });
+
+        runner.run(QStringLiteral("transformStore/flushSparse/100000"), count / 100, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            for (int i = 0; i < count; i += 100) store.markDirty(i);
+            stopwatch.restart();
+            runner.consume(store.flush(matrices.data()));
+            });
+
+        runner.run(QStringLiteral("transformStore/worldMatrix/100000"), count, [&](BenchmarkRunner::Stopwatch&) {
+            // Scalar reference for the batched flush
+            for (int i = 0; i < count; ++i) {
+                matrices[i] = store.worldMatrix(i);
+            }
+            runner.consume(quint64(matrices[count / 2][3][0]));
+            });
+    }
+
+    void rayPickerBenchmarks(BenchmarkRunner& runner)
+    {
+        const int objects = 10000;
+        const int rays = 10000;
+
+        // Unit cube, 12 triangles
+        const std::vector<glm::vec3> positions = {
+            { -1, -1, -1 }, { 1, -1, -1 }, { -1, 1, -1 }, { 1, 1, -1 },
+            { -1, -1, 1 }, { 1, -1, 1 }, { -1, 1, 1 }, { 1, 1, 1 },
+        };
+        const std::vector<uint32_t> indices = {
+            0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1,
+            2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3,
+        };
+
+        std::unique_ptr<RayPicker> picker(new RayPicker());
+        const int mesh = picker->addMesh(positions, indices);
+        std::mt19937 rng(6);
+        std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+        for (int i = 0; i < objects; ++i) {
+            picker->addObject(mesh, glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), position(rng), position(rng))), i);
+        }
+
+        const glm::mat4 inverseViewProjection = glm::inverse(viewProjection());
+        std::uniform_real_distribution<float> ndc(-1.0f, 1.0f);
+        std::vector<Ray> queries;
+        queries.reserve(rays);
+        for (int i = 0; i < rays; ++i) {
+            queries.push_back(Ray::fromNdc(ndc(rng), ndc(rng), inverseViewProjection));
+        }
+
+        runner.run(QStringLiteral("rayPicker/pick/10000x10000"), rays, [&](BenchmarkRunner::Stopwatch&) {
+            quint64 hits = 0;
+            for (const Ray& ray : queries) {
+                if (picker->pick(ray).isValid()) ++hits;
+            }
+            runner.consume(hits);
+            });
+    }
+}
+
+// ===================================================================
+// == Core suite
+// ===================================================================
+void runCoreBenchmarks(BenchmarkRunner& runner)
+{
+    outlinerBenchmarks(runner);
+    slotMapBenchmarks(runner);
+    tlsfBenchmarks(runner);
+    bvhBenchmarks(runner);
+    transformStoreBenchmarks(runner);
+    rayPickerBenchmarks(runner);
+}
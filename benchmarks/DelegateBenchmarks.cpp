@@ -0,0 +1,78 @@
+#include "BenchmarkRunner.h"
+
+#include "EyeIconDelegate.h"
+#include "OutlinerModel.h"
+
+#include <QApplication>
+#include <QImage>
+#include <QPainter>
+#include <QStyleOptionViewItem>
+#include <algorithm>
+
+namespace {
+    const int PAINTED_ROWS = 100000;
+    const int ROWS_PER_IMAGE = 40;   // About one outliner panel's worth of rows
+    const int ROW_WIDTH = 320;
+
+    // Paints `rows` rows of `model` through `delegate` into an offscreen image, one panel at a time
+    void paintRows(QAbstractItemDelegate& delegate, const OutlinerModel& model, int rows, qreal devicePixelRatio)
+    {
+        QStyleOptionViewItem option;
+        option.palette = QApplication::palette();
+        option.direction = QApplication::layoutDirection();
+        option.font = QApplication::font();
+        option.fontMetrics = QFontMetrics(option.font);
+        option.state = QStyle::State_Enabled;
+        const int rowHeight = std::max(16, delegate.sizeHint(option, model.index(0, 0)).height());
+
+        QImage image(qRound(ROW_WIDTH * devicePixelRatio), qRound(rowHeight * ROWS_PER_IMAGE * devicePixelRatio),
+            QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(devicePixelRatio);
+        image.fill(Qt::white);
+        QPainter painter(&image);
+
+        for (int row = 0; row < rows; ++row) {
+            option.rect = QRect(0, (row % ROWS_PER_IMAGE) * rowHeight, ROW_WIDTH, rowHeight);
+            delegate.paint(&painter, option, model.index(row % model.primitiveCount(), 0));
+        }
+    }
+}
+
+// ===================================================================
+// == Delegate suite
+// ===================================================================
+void runDelegateBenchmarks(BenchmarkRunner& runner)
+{
+    // Alternate visible and hidden rows so both icons are drawn
+    OutlinerModel model;
+    model.appendPrimitives(makeHandles(1000), QStringLiteral("Cube"));
+    for (int row = 1; row < model.primitiveCount(); row += 2) {
+        model.setData(model.index(row, 0), false, Qt::UserRole);
+    }
+
+    runner.run(QStringLiteral("eyeIconDelegate/firstPaint"), 1, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+        // Resolving the icon paths and building the pixmap cache
+        stopwatch.restart();
+        EyeIconDelegate delegate;
+        paintRows(delegate, model, 2, 1.0);
+        stopwatch.stop();
+        });
+
+    EyeIconDelegate delegate;
+    paintRows(delegate, model, 2, 1.0);
+    paintRows(delegate, model, 2, 2.0);
+
+    runner.run(QStringLiteral("eyeIconDelegate/paint/100000"), PAINTED_ROWS, [&](BenchmarkRunner::Stopwatch&) {
+        paintRows(delegate, model, PAINTED_ROWS, 1.0);
+        });
+
+    runner.run(QStringLiteral("eyeIconDelegate/paintHiDpi/100000"), PAINTED_ROWS, [&](BenchmarkRunner::Stopwatch&) {
+        paintRows(delegate, model, PAINTED_ROWS, 2.0);
+        });
+
+    // Text-only baseline: the difference to eyeIconDelegate/paint is the icon's cost
+    QStyledItemDelegate plain;
+    runner.run(QStringLiteral("styledItemDelegate/paint/100000"), PAINTED_ROWS, [&](BenchmarkRunner::Stopwatch&) {
+        paintRows(plain, model, PAINTED_ROWS, 1.0);
+        });
+}
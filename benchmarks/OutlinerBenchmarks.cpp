@@ -0,0 +1,88 @@
+#include "BenchmarkRunner.h"
+
+#include "EyeIconDelegate.h"
+#include "OutlinerModel.h"
+
+#include <QApplication>
+#include <QScrollBar>
+#include <QTreeView>
+#include <vector>
+
+namespace {
+    const int VIEW_SIZES[] = { 100000, 1000000 };
+    const int SCROLL_STEPS = 200;
+
+    // Same setup as the editor's outliner panel
+    void configureView(QTreeView& view, OutlinerModel& model)
+    {
+        view.setModel(&model);
+        view.setHeaderHidden(true);
+        view.setRootIsDecorated(false);
+        view.setUniformRowHeights(true);
+        view.setItemDelegate(new EyeIconDelegate(&view));
+        view.resize(320, 720);
+        view.show();
+        QApplication::processEvents();
+    }
+
+    // Runs pending layouts and paints the visible rows synchronously
+    void settle(QTreeView& view)
+    {
+        QApplication::processEvents();
+        view.viewport()->repaint();
+    }
+}
+
+// ===================================================================
+// == Outliner view suite
+// ===================================================================
+void runOutlinerBenchmarks(BenchmarkRunner& runner)
+{
+    for (int count : VIEW_SIZES) {
+        const std::vector<PrimitiveHandle> handles = makeHandles(count);
+        const QString suffix = QStringLiteral("/%1").arg(count);
+
+        runner.run(QStringLiteral("outlinerView/spawn") + suffix, count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            OutlinerModel model;
+            QTreeView view;
+            configureView(view, model);
+
+            stopwatch.restart();
+            model.appendPrimitives(handles, QStringLiteral("Cube"));
+            settle(view);
+            stopwatch.stop();
+            });
+
+        runner.run(QStringLiteral("outlinerView/scroll") + suffix, SCROLL_STEPS, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            OutlinerModel model;
+            QTreeView view;
+            configureView(view, model);
+            model.appendPrimitives(handles, QStringLiteral("Cube"));
+            settle(view);
+
+            // Jumps spread over the whole list, each followed by a full repaint of the visible rows
+            QScrollBar* scrollBar = view.verticalScrollBar();
+            const int maximum = scrollBar->maximum();
+            stopwatch.restart();
+            for (int step = 0; step < SCROLL_STEPS; ++step) {
+                scrollBar->setValue(int(qint64(maximum) * step / (SCROLL_STEPS - 1)));
+                view.viewport()->repaint();
+            }
+            stopwatch.stop();
+            runner.consume(scrollBar->value());
+            });
+
+        runner.run(QStringLiteral("outlinerView/clear") + suffix, count, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+            OutlinerModel model;
+            QTreeView view;
+            configureView(view, model);
+            model.appendPrimitives(handles, QStringLiteral("Cube"));
+            settle(view);
+
+            stopwatch.restart();
+            model.clear();
+            settle(view);
+            stopwatch.stop();
+            });
+    }
+}
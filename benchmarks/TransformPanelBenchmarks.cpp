@@ -0,0 +1,89 @@
+#include "BenchmarkRunner.h"
+
+#include "TransformPanel.h"
+
+#include <QDoubleSpinBox>
+#include <array>
+#include <memory>
+
+namespace {
+    const int ROUND_TRIPS = 10000;
+    const int DRAG_STEPS = 100000;
+
+    // The nine Transform boxes, configured like the editor's properties panel
+    struct PanelWidgets {
+        std::array<std::unique_ptr<QDoubleSpinBox>, 9> spins;
+        TransformPanel panel;
+
+        PanelWidgets()
+        {
+            for (auto& spin : spins) {
+                spin.reset(new QDoubleSpinBox());
+                spin->setRange(-999999, 999999);
+                spin->setDecimals(3);
+            }
+            for (int channel = TransformPanel::Translate; channel < TransformPanel::ChannelCount; ++channel) {
+                panel.setSpinBoxes(TransformPanel::Channel(channel),
+                    spins[channel * 3].get(), spins[channel * 3 + 1].get(), spins[channel * 3 + 2].get());
+            }
+        }
+    };
+}
+
+// ===================================================================
+// == Transform panel suite
+// ===================================================================
+void runTransformPanelBenchmarks(BenchmarkRunner& runner)
+{
+    const std::vector<PrimitiveHandle> handles = makeHandles(2);
+
+    runner.run(QStringLiteral("transformPanel/setValues/10000"), ROUND_TRIPS, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+        PanelWidgets widgets;
+
+        // Selection flips between two primitives, so every box changes
+        stopwatch.restart();
+        for (int i = 0; i < ROUND_TRIPS; ++i) {
+            const float v = float(i & 1);
+            widgets.panel.setValues(glm::vec3(v), glm::vec3(v * 90.0f), glm::vec3(1.0f + v));
+        }
+        stopwatch.stop();
+        runner.consume(quint64(widgets.panel.values(TransformPanel::Scale).x));
+        });
+
+    runner.run(QStringLiteral("transformPanel/roundTrip/10000"), ROUND_TRIPS, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+        PanelWidgets widgets;
+        quint64 delivered = 0;
+        QObject::connect(&widgets.panel, &TransformPanel::transformEdited, [&](PrimitiveHandle, TransformPanel::Channel, const glm::vec3& values) {
+            delivered += quint64(values.x);
+            });
+
+        // Select (updateTransformPanel), edit one box, deliver the merged edit at the frame tick
+        stopwatch.restart();
+        for (int i = 0; i < ROUND_TRIPS; ++i) {
+            widgets.panel.setPrimitive(handles[i & 1]);
+            widgets.panel.setValues(glm::vec3(float(i)), glm::vec3(0.0f), glm::vec3(1.0f));
+            widgets.spins[0]->setValue(i + 1);
+            widgets.panel.flush();
+        }
+        stopwatch.stop();
+        runner.consume(delivered);
+        });
+
+    runner.run(QStringLiteral("transformPanel/dragMerge/100000"), DRAG_STEPS, [&](BenchmarkRunner::Stopwatch& stopwatch) {
+        PanelWidgets widgets;
+        quint64 delivered = 0;
+        QObject::connect(&widgets.panel, &TransformPanel::transformEdited, [&](PrimitiveHandle, TransformPanel::Channel, const glm::vec3&) {
+            ++delivered;
+            });
+        widgets.panel.setPrimitive(handles[0]);
+
+        // A drag produces one edit per step; one frame tick delivers them as a single update
+        stopwatch.restart();
+        for (int step = 0; step < DRAG_STEPS; ++step) {
+            widgets.spins[step % 3]->setValue(step * 0.01);
+        }
+        widgets.panel.flush();
+        stopwatch.stop();
+        runner.consume(delivered);
+        });
+}
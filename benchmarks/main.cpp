@@ -0,0 +1,61 @@
+#include "BenchmarkRunner.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTextStream>
+
+int main(int argc, char* argv[])
+{
+    // Headless by default so the suite runs on build machines without a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("CPU benchmarks for the editor's hot paths; writes a JSON report"));
+    parser.addHelpOption();
+    const QCommandLineOption outputOption({ QStringLiteral("o"), QStringLiteral("output") },
+        QStringLiteral("Write the JSON report to <file> instead of stdout."), QStringLiteral("file"));
+    const QCommandLineOption repeatsOption({ QStringLiteral("r"), QStringLiteral("repeats") },
+        QStringLiteral("Runs per benchmark (default 5)."), QStringLiteral("count"), QStringLiteral("5"));
+    const QCommandLineOption filterOption({ QStringLiteral("f"), QStringLiteral("filter") },
+        QStringLiteral("Only run benchmarks whose name contains <text>; may be repeated."), QStringLiteral("text"));
+    parser.addOption(outputOption);
+    parser.addOption(repeatsOption);
+    parser.addOption(filterOption);
+    parser.process(app);
+
+    BenchmarkRunner runner(parser.value(repeatsOption).toInt(), parser.values(filterOption));
+    runCoreBenchmarks(runner);
+    runOutlinerBenchmarks(runner);
+    runDelegateBenchmarks(runner);
+    runTransformPanelBenchmarks(runner);
+
+    QJsonObject report;
+    report.insert(QStringLiteral("schema"), 1);
+    report.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    report.insert(QStringLiteral("qtVersion"), QString::fromLatin1(qVersion()));
+    report.insert(QStringLiteral("os"), QSysInfo::prettyProductName());
+    report.insert(QStringLiteral("cpuArchitecture"), QSysInfo::currentCpuArchitecture());
+    report.insert(QStringLiteral("benchmarks"), runner.results());
+    const QByteArray json = QJsonDocument(report).toJson();
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            QTextStream(stderr) << "Cannot write " << file.fileName() << ": " << file.errorString() << '\n';
+            return 1;
+        }
+        file.write(json);
+    }
+    else {
+        QTextStream(stdout) << json;
+    }
+    return 0;
+}
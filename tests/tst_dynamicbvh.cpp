@@ -0,0 +1,251 @@
+#include "DynamicBvh.h"
+
+#include <QtTest>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+    bool overlaps(const Aabb& a, const Aabb& b)
+    {
+        return !(a.max.x < b.min.x || a.min.x > b.max.x ||
+            a.max.y < b.min.y || a.min.y > b.max.y ||
+            a.max.z < b.min.z || a.min.z > b.max.z);
+    }
+
+    Aabb randomBox(std::mt19937& rng, float range)
+    {
+        std::uniform_real_distribution<float> position(-range, range);
+        std::uniform_real_distribution<float> size(0.1f, 3.0f);
+        const glm::vec3 center(position(rng), position(rng), position(rng));
+        const glm::vec3 extents(size(rng), size(rng), size(rng));
+        return { center - extents, center + extents };
+    }
+
+    // Live objects by user data, mirrored outside the tree for brute-force checks
+    struct Scene {
+        std::vector<Aabb> boxes;
+        std::vector<int> proxies;   // NULL_NODE once removed
+    };
+}
+
+
+// ===================================================================
+// == TestDynamicBvh Declaration
+// ===================================================================
+class TestDynamicBvh : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void emptyTree();
+    void insertRemoveKeepsStructure();
+    void updateRefitsOnlyOutsideFatBox();
+    void staysBalancedUnderSortedInserts();
+    void boxQueryMatchesBruteForce();
+    void frustumQueryMatchesBruteForce();
+
+private:
+    // Walks the tree from the root and checks links, bounds and heights; returns the leaf count
+    int validate(const DynamicBvh& bvh, int& maxImbalance);
+    void churn(DynamicBvh& bvh, Scene& scene, int count);
+};
+
+// ===================================================================
+// == TestDynamicBvh Implementation
+// ===================================================================
+int TestDynamicBvh::validate(const DynamicBvh& bvh, int& maxImbalance)
+{
+    maxImbalance = 0;
+    if (bvh.root() == DynamicBvh::NULL_NODE) return 0;
+    if (bvh.node(bvh.root()).parent != DynamicBvh::NULL_NODE) return -1;
+
+    int leaves = 0;
+    std::vector<int> stack{ bvh.root() };
+    while (!stack.empty()) {
+        const int index = stack.back();
+        stack.pop_back();
+        const DynamicBvh::Node& n = bvh.node(index);
+
+        if (n.isLeaf()) {
+            if (n.height != 0 || n.child2 != DynamicBvh::NULL_NODE) return -1;
+            ++leaves;
+            continue;
+        }
+
+        const DynamicBvh::Node& a = bvh.node(n.child1);
+        const DynamicBvh::Node& b = bvh.node(n.child2);
+        if (a.parent != index || b.parent != index) return -1;
+        if (n.height != 1 + std::max(a.height, b.height)) return -1;
+        if (!n.box.contains(a.box) || !n.box.contains(b.box)) return -1;
+        maxImbalance = std::max(maxImbalance, std::abs(a.height - b.height));
+
+        stack.push_back(n.child1);
+        stack.push_back(n.child2);
+    }
+    return leaves;
+}
+
+void TestDynamicBvh::churn(DynamicBvh& bvh, Scene& scene, int count)
+{
+    std::mt19937 rng(11);
+    for (int i = 0; i < count; ++i) {
+        scene.boxes.push_back(randomBox(rng, 200.0f));
+        scene.proxies.push_back(bvh.insert(scene.boxes.back(), i));
+    }
+
+    // Remove every third object and move every third one far enough to leave its fat box
+    for (int i = 0; i < count; i += 3) {
+        bvh.remove(scene.proxies[i]);
+        scene.proxies[i] = DynamicBvh::NULL_NODE;
+    }
+    for (int i = 1; i < count; i += 3) {
+        const glm::vec3 offset(5.0f, -2.0f, 1.0f);
+        scene.boxes[i] = { scene.boxes[i].min + offset, scene.boxes[i].max + offset };
+        bvh.update(scene.proxies[i], scene.boxes[i]);
+    }
+}
+
+void TestDynamicBvh::emptyTree()
+{
+    DynamicBvh bvh;
+    QCOMPARE(bvh.leafCount(), 0);
+    QCOMPARE(bvh.height(), 0);
+
+    int visited = 0;
+    bvh.query(Aabb{ glm::vec3(-1.0f), glm::vec3(1.0f) }, [&](int) { ++visited; });
+    QCOMPARE(visited, 0);
+
+    const int proxy = bvh.insert(Aabb{ glm::vec3(-1.0f), glm::vec3(1.0f) }, 7);
+    QCOMPARE(bvh.root(), proxy);
+    QCOMPARE(bvh.userData(proxy), 7);
+    bvh.remove(proxy);
+    QCOMPARE(bvh.root(), DynamicBvh::NULL_NODE);
+    QCOMPARE(bvh.leafCount(), 0);
+}
+
+void TestDynamicBvh::insertRemoveKeepsStructure()
+{
+    DynamicBvh bvh;
+    Scene scene;
+    churn(bvh, scene, 3000);
+
+    int maxImbalance = 0;
+    QCOMPARE(validate(bvh, maxImbalance), bvh.leafCount());
+    QCOMPARE(bvh.leafCount(), 2000);
+
+    for (size_t i = 0; i < scene.proxies.size(); ++i) {
+        if (scene.proxies[i] == DynamicBvh::NULL_NODE) continue;
+        QCOMPARE(bvh.userData(scene.proxies[i]), static_cast<int>(i));
+        QVERIFY(bvh.fatBounds(scene.proxies[i]).contains(scene.boxes[i]));
+    }
+
+    // Emptying the tree and refilling it reuses the freed nodes
+    for (int& proxy : scene.proxies) {
+        if (proxy == DynamicBvh::NULL_NODE) continue;
+        bvh.remove(proxy);
+        proxy = DynamicBvh::NULL_NODE;
+    }
+    QCOMPARE(bvh.leafCount(), 0);
+    QCOMPARE(bvh.root(), DynamicBvh::NULL_NODE);
+
+    std::mt19937 rng(3);
+    for (int i = 0; i < 100; ++i) {
+        QVERIFY(bvh.insert(randomBox(rng, 50.0f), i) < 2 * 3000);
+    }
+    QCOMPARE(validate(bvh, maxImbalance), 100);
+}
+
+void TestDynamicBvh::updateRefitsOnlyOutsideFatBox()
+{
+    DynamicBvh bvh(0.5f);
+    const Aabb box{ glm::vec3(0.0f), glm::vec3(1.0f) };
+    const int proxy = bvh.insert(box, 0);
+    bvh.insert(Aabb{ glm::vec3(10.0f), glm::vec3(11.0f) }, 1);
+
+    const glm::vec3 nudge(0.25f, 0.0f, 0.0f);
+    QVERIFY(!bvh.update(proxy, { box.min + nudge, box.max + nudge }));
+    QCOMPARE(bvh.fatBounds(proxy).min.x, -0.5f);
+
+    const glm::vec3 jump(4.0f, 0.0f, 0.0f);
+    const Aabb moved{ box.min + jump, box.max + jump };
+    QVERIFY(bvh.update(proxy, moved));
+    QVERIFY(bvh.fatBounds(proxy).contains(moved));
+    QCOMPARE(bvh.fatBounds(proxy).min.x, 3.5f);
+
+    int maxImbalance = 0;
+    QCOMPARE(validate(bvh, maxImbalance), 2);
+}
+
+void TestDynamicBvh::staysBalancedUnderSortedInserts()
+{
+    // A row of boxes inserted in order degenerates into a list without rotations
+    DynamicBvh bvh;
+    const int count = 4096;
+    for (int i = 0; i < count; ++i) {
+        const glm::vec3 min(float(i) * 2.0f, 0.0f, 0.0f);
+        bvh.insert(Aabb{ min, min + glm::vec3(1.0f) }, i);
+    }
+
+    int maxImbalance = 0;
+    QCOMPARE(validate(bvh, maxImbalance), count);
+    QVERIFY(maxImbalance <= 2);
+    QVERIFY(bvh.height() <= 2 * int(std::log2(double(count))));
+}
+
+void TestDynamicBvh::boxQueryMatchesBruteForce()
+{
+    DynamicBvh bvh;
+    Scene scene;
+    churn(bvh, scene, 3000);
+
+    std::mt19937 rng(5);
+    for (int q = 0; q < 50; ++q) {
+        const Aabb query = randomBox(rng, 200.0f).expanded(20.0f);
+
+        std::vector<int> found;
+        bvh.query(query, [&](int userData) { found.push_back(userData); });
+        std::sort(found.begin(), found.end());
+
+        std::vector<int> expected;
+        for (size_t i = 0; i < scene.proxies.size(); ++i) {
+            if (scene.proxies[i] == DynamicBvh::NULL_NODE) continue;
+            if (overlaps(bvh.fatBounds(scene.proxies[i]), query)) expected.push_back(static_cast<int>(i));
+            // Fat boxes may add candidates but never lose a real overlap
+            if (overlaps(scene.boxes[i], query)) {
+                QVERIFY(std::binary_search(found.begin(), found.end(), static_cast<int>(i)));
+            }
+        }
+        QCOMPARE(found, expected);
+    }
+}
+
+void TestDynamicBvh::frustumQueryMatchesBruteForce()
+{
+    DynamicBvh bvh;
+    Scene scene;
+    churn(bvh, scene, 3000);
+
+    const glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+    const glm::vec3 eyes[] = { glm::vec3(0.0f), glm::vec3(-150.0f, 20.0f, 80.0f), glm::vec3(0.0f, 300.0f, 0.0f) };
+    for (const glm::vec3& eye : eyes) {
+        const Frustum frustum(projection * glm::lookAt(eye, glm::vec3(10.0f, 0.0f, -30.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+
+        std::vector<int> found;
+        bvh.query(frustum, [&](int userData) { found.push_back(userData); });
+        std::sort(found.begin(), found.end());
+
+        // Subtrees reported as Inside skip per-leaf tests, which must not change the result
+        std::vector<int> expected;
+        for (size_t i = 0; i < scene.proxies.size(); ++i) {
+            if (scene.proxies[i] == DynamicBvh::NULL_NODE) continue;
+            if (frustum.intersects(bvh.fatBounds(scene.proxies[i]))) expected.push_back(static_cast<int>(i));
+        }
+        QCOMPARE(found, expected);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestDynamicBvh)
+
+#include "tst_dynamicbvh.moc"
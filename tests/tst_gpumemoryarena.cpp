@@ -0,0 +1,239 @@
+#include "GpuMemoryArena.h"
+
+#include <QtTest>
+#include <algorithm>
+#include <random>
+#include <set>
+
+namespace {
+    // Hands out fake memory handles and tracks which are live, so tests can
+    // check driver call counts and leaks without a device
+    class MockBackend : public GpuMemoryArena::Backend
+    {
+    public:
+        VkDeviceMemory allocateBlock(VkDeviceSize size, uint32_t memoryTypeIndex) override
+        {
+            Q_UNUSED(memoryTypeIndex);
+            if (failNext) {
+                failNext = false;
+                return VK_NULL_HANDLE;
+            }
+            ++allocateCalls;
+            allocatedBytes += size;
+            const VkDeviceMemory memory = reinterpret_cast<VkDeviceMemory>(static_cast<uintptr_t>(++m_nextHandle) * 0x1000);
+            live.insert(memory);
+            return memory;
+        }
+
+        void freeBlock(VkDeviceMemory memory) override
+        {
+            QVERIFY(live.erase(memory) == 1);
+        }
+
+        std::set<VkDeviceMemory> live;
+        int allocateCalls = 0;
+        VkDeviceSize allocatedBytes = 0;
+        bool failNext = false;
+
+    private:
+        quint64 m_nextHandle = 0;
+    };
+
+    constexpr VkDeviceSize BLOCK_SIZE = 1024 * 1024;
+
+    bool overlaps(const GpuMemoryArena::Allocation& a, const GpuMemoryArena::Allocation& b)
+    {
+        return a.memory == b.memory && a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+    }
+}
+
+
+// ===================================================================
+// == TestGpuMemoryArena Declaration
+// ===================================================================
+class TestGpuMemoryArena : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sharesBlocksBetweenAllocations();
+    void largeRequestsGetDedicatedBlocks();
+    void reportsBackendFailure();
+    void wastedBytesCountsRoundingOnly();
+    void defragmentationEmptiesSparseBlocks();
+    void destroyReleasesEveryBlock();
+};
+
+// ===================================================================
+// == TestGpuMemoryArena Implementation
+// ===================================================================
+void TestGpuMemoryArena::sharesBlocksBetweenAllocations()
+{
+    MockBackend backend;
+    GpuMemoryArena arena;
+    arena.create(&backend, 0, BLOCK_SIZE);
+
+    std::vector<int> ids;
+    for (int i = 0; i < 100; ++i) {
+        const int id = arena.allocate(4000, 256);
+        QVERIFY(id != GpuMemoryArena::NULL_ALLOCATION);
+        QCOMPARE(arena.allocation(id).offset % 256, VkDeviceSize(0));
+        ids.push_back(id);
+    }
+    QCOMPARE(backend.allocateCalls, 1);
+
+    for (size_t a = 0; a < ids.size(); ++a) {
+        for (size_t b = a + 1; b < ids.size(); ++b) {
+            QVERIFY(!overlaps(arena.allocation(ids[a]), arena.allocation(ids[b])));
+        }
+    }
+
+    // Freed ranges are reused before another block is requested
+    for (int id : ids) arena.free(id);
+    QVERIFY(arena.allocate(BLOCK_SIZE / 2, 256) != GpuMemoryArena::NULL_ALLOCATION);
+    QCOMPARE(backend.allocateCalls, 1);
+    QCOMPARE(arena.stats().blockCount, 1);
+}
+
+void TestGpuMemoryArena::largeRequestsGetDedicatedBlocks()
+{
+    MockBackend backend;
+    GpuMemoryArena arena;
+    arena.create(&backend, 0, BLOCK_SIZE);
+
+    const int small = arena.allocate(1024, 16);
+    const int large = arena.allocate(BLOCK_SIZE * 3, 256);
+    QVERIFY(small != GpuMemoryArena::NULL_ALLOCATION);
+    QVERIFY(large != GpuMemoryArena::NULL_ALLOCATION);
+    QCOMPARE(backend.allocateCalls, 2);
+    QCOMPARE(arena.allocation(large).offset, VkDeviceSize(0));
+    QVERIFY(arena.allocation(large).memory != arena.allocation(small).memory);
+
+    // The dedicated block goes back to the backend as soon as it is empty
+    arena.free(large);
+    QCOMPARE(backend.live.size(), size_t(1));
+    QCOMPARE(arena.stats().blockCount, 1);
+}
+
+void TestGpuMemoryArena::reportsBackendFailure()
+{
+    MockBackend backend;
+    GpuMemoryArena arena;
+    arena.create(&backend, 0, BLOCK_SIZE);
+
+    backend.failNext = true;
+    QCOMPARE(arena.allocate(1024, 16), GpuMemoryArena::NULL_ALLOCATION);
+    QCOMPARE(arena.stats().blockCount, 0);
+    QCOMPARE(arena.allocate(0, 16), GpuMemoryArena::NULL_ALLOCATION);
+
+    QVERIFY(arena.allocate(1024, 16) != GpuMemoryArena::NULL_ALLOCATION);
+    QCOMPARE(arena.stats().allocationCount, 1);
+}
+
+void TestGpuMemoryArena::wastedBytesCountsRoundingOnly()
+{
+    MockBackend backend;
+    GpuMemoryArena arena;
+    arena.create(&backend, 0, BLOCK_SIZE);
+
+    // 100 bytes round up to 112; the 4096 alignment of the second request
+    // leaves padding in front of it, which stays a free range
+    QVERIFY(arena.allocate(100, 16) != GpuMemoryArena::NULL_ALLOCATION);
+    const int aligned = arena.allocate(100, 4096);
+    QVERIFY(aligned != GpuMemoryArena::NULL_ALLOCATION);
+    QCOMPARE(arena.allocation(aligned).offset, VkDeviceSize(4096));
+
+    const GpuMemoryArena::Stats stats = arena.stats();
+    QCOMPARE(stats.allocationCount, 2);
+    QCOMPARE(stats.reservedBytes, BLOCK_SIZE);
+    QCOMPARE(stats.usedBytes, VkDeviceSize(2 * 112));
+    QCOMPARE(stats.wastedBytes, VkDeviceSize(2 * 12));
+    QCOMPARE(stats.freeBytes, BLOCK_SIZE - 2 * 112);
+    QCOMPARE(stats.freeRangeCount, 2);
+    QCOMPARE(stats.largestFreeRange, BLOCK_SIZE - 4096 - 112);
+    QVERIFY(stats.fragmentation > 0.0);
+}
+
+void TestGpuMemoryArena::defragmentationEmptiesSparseBlocks()
+{
+    MockBackend backend;
+    GpuMemoryArena arena;
+    arena.create(&backend, 0, BLOCK_SIZE);
+
+    std::mt19937 rng(7);
+    std::vector<int> ids;
+    for (int i = 0; i < 2000; ++i) {
+        const int id = arena.allocate(256 + rng() % 8000, 256);
+        QVERIFY(id != GpuMemoryArena::NULL_ALLOCATION);
+        ids.push_back(id);
+    }
+    const int blocksBefore = arena.stats().blockCount;
+    QVERIFY(blocksBefore > 2);
+
+    // Leave a scattering of live allocations in every block
+    std::vector<int> live;
+    for (int id : ids) {
+        if (rng() % 4 == 0) live.push_back(id);
+        else arena.free(id);
+    }
+
+    std::vector<GpuMemoryArena::Allocation> before;
+    for (int id : live) before.push_back(arena.allocation(id));
+
+    const std::vector<GpuMemoryArena::Move> moves = arena.planDefragmentation(~VkDeviceSize(0));
+    QVERIFY(!moves.empty());
+    QVERIFY(arena.isDefragmenting());
+    QVERIFY(arena.planDefragmentation(~VkDeviceSize(0)).empty());
+
+    for (const GpuMemoryArena::Move& move : moves) {
+        const GpuMemoryArena::Allocation& moved = arena.allocation(move.allocation);
+        QCOMPARE(moved.memory, move.dstMemory);
+        QCOMPARE(moved.offset, move.dstOffset);
+        QCOMPARE(moved.offset % 256, VkDeviceSize(0));
+
+        const auto index = std::find(live.begin(), live.end(), move.allocation) - live.begin();
+        QCOMPARE(before[index].memory, move.srcMemory);
+        QCOMPARE(before[index].offset, move.srcOffset);
+
+        // Destinations must not land on a range that is still being read from
+        for (const GpuMemoryArena::Move& other : moves) {
+            GpuMemoryArena::Allocation source;
+            source.memory = other.srcMemory;
+            source.offset = other.srcOffset;
+            source.size = other.size;
+            QVERIFY(!overlaps(moved, source));
+        }
+    }
+    for (size_t a = 0; a < live.size(); ++a) {
+        for (size_t b = a + 1; b < live.size(); ++b) {
+            QVERIFY(!overlaps(arena.allocation(live[a]), arena.allocation(live[b])));
+        }
+    }
+
+    arena.finishDefragmentation();
+    QVERIFY(!arena.isDefragmenting());
+    const GpuMemoryArena::Stats stats = arena.stats();
+    QCOMPARE(stats.allocationCount, static_cast<int>(live.size()));
+    QVERIFY(stats.blockCount < blocksBefore);
+    QCOMPARE(backend.live.size(), size_t(stats.blockCount));
+}
+
+void TestGpuMemoryArena::destroyReleasesEveryBlock()
+{
+    MockBackend backend;
+    {
+        GpuMemoryArena arena;
+        arena.create(&backend, 0, BLOCK_SIZE);
+        for (int i = 0; i < 50; ++i) {
+            QVERIFY(arena.allocate(64 * 1024, 256) != GpuMemoryArena::NULL_ALLOCATION);
+        }
+        QVERIFY(arena.allocate(BLOCK_SIZE * 2, 256) != GpuMemoryArena::NULL_ALLOCATION);
+        QVERIFY(backend.live.size() > 2);
+        QCOMPARE(backend.live.size(), size_t(backend.allocateCalls));
+    }
+    QVERIFY(backend.live.empty());
+}
+
+QTEST_APPLESS_MAIN(TestGpuMemoryArena)
+
+#include "tst_gpumemoryarena.moc"
@@ -0,0 +1,193 @@
+#include "OcclusionCuller.h"
+
+#include <QtTest>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+
+namespace {
+    // Camera at the origin looking down -Z, matching the editor's Vulkan projection
+    glm::mat4 perspectiveView()
+    {
+        return glm::perspectiveRH_ZO(glm::radians(60.0f), 2.0f, 0.1f, 200.0f);
+    }
+
+    // 10x10 wall one unit thick, ten units in front of the camera
+    const Aabb WALL{ glm::vec3(-5.0f, -5.0f, -11.0f), glm::vec3(5.0f, 5.0f, -10.0f) };
+}
+
+
+// ===================================================================
+// == TestOcclusionCuller Declaration
+// ===================================================================
+class TestOcclusionCuller : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundsToPowersOfTwo();
+    void rasterizesNearestDepth();
+    void hierarchyKeepsFarthestDepth();
+    void hidesBoxBehindOccluder();
+    void keepsPartlyHiddenBox();
+    void keepsBoxInFrontOfOccluder();
+    void keepsBoxCrossingNearPlane();
+    void rejectsOccluderCrossingNearPlane();
+    void picksLargestOccluders();
+};
+
+// ===================================================================
+// == TestOcclusionCuller Implementation
+// ===================================================================
+void TestOcclusionCuller::roundsToPowersOfTwo()
+{
+    OcclusionCuller culler(200, 3);
+    QCOMPARE(culler.width(), 256);
+    QCOMPARE(culler.height(), 4);
+    QCOMPARE(culler.levelCount(), 9);
+    QCOMPARE(culler.levelWidth(8), 1);
+    QCOMPARE(culler.levelHeight(8), 1);
+}
+
+void TestOcclusionCuller::rasterizesNearestDepth()
+{
+    // Orthographic: x and y in [-10, 10] map to the whole buffer, depth = z / 100
+    glm::mat4 orthographic(1.0f);
+    orthographic[0][0] = 0.1f;
+    orthographic[1][1] = 0.1f;
+    orthographic[2][2] = 0.01f;
+
+    OcclusionCuller culler(256, 128);
+    culler.beginFrame(orthographic);
+    culler.rasterizeOccluder(Aabb{ glm::vec3(-5.0f, -5.0f, 10.0f), glm::vec3(5.0f, 5.0f, 20.0f) });
+    QCOMPARE(culler.stats().occludersRasterized, 1);
+
+    // The box covers the middle half of the buffer on both axes; its near face wins
+    const float* depth = culler.depth();
+    const int width = culler.width();
+    QVERIFY(qAbs(depth[64 * width + 128] - 0.1f) < 1e-4f);
+    QVERIFY(qAbs(depth[40 * width + 70] - 0.1f) < 1e-4f);
+    QCOMPARE(depth[10 * width + 10], 1.0f);
+    QCOMPARE(depth[64 * width + 250], 1.0f);
+
+    // A nearer occluder overwrites, a farther one does not
+    culler.rasterizeOccluder(Aabb{ glm::vec3(-1.0f, -1.0f, 5.0f), glm::vec3(1.0f, 1.0f, 6.0f) });
+    culler.rasterizeOccluder(Aabb{ glm::vec3(2.0f, 2.0f, 50.0f), glm::vec3(4.0f, 4.0f, 60.0f) });
+    QVERIFY(qAbs(depth[64 * width + 128] - 0.05f) < 1e-4f);
+    QVERIFY(qAbs(depth[(64 + 19) * width + 128 + 38] - 0.1f) < 1e-4f);
+}
+
+void TestOcclusionCuller::hierarchyKeepsFarthestDepth()
+{
+    OcclusionCuller culler(256, 128);
+    culler.beginFrame(perspectiveView());
+    culler.rasterizeOccluder(WALL);
+    culler.buildHierarchy();
+
+    // The wall does not cover the whole view, so the 1x1 level still sees the far plane
+    QCOMPARE(culler.depth(culler.levelCount() - 1)[0], 1.0f);
+
+    for (int level = 1; level < culler.levelCount(); ++level) {
+        const int width = culler.levelWidth(level);
+        const int srcWidth = culler.levelWidth(level - 1);
+        const int srcHeight = culler.levelHeight(level - 1);
+        for (int y = 0; y < culler.levelHeight(level); ++y) {
+            for (int x = 0; x < width; ++x) {
+                float farthest = 0.0f;
+                for (int sy = y * 2; sy <= std::min(y * 2 + 1, srcHeight - 1); ++sy) {
+                    for (int sx = x * 2; sx <= std::min(x * 2 + 1, srcWidth - 1); ++sx) {
+                        farthest = std::max(farthest, culler.depth(level - 1)[sy * srcWidth + sx]);
+                    }
+                }
+                QCOMPARE(culler.depth(level)[y * width + x], farthest);
+            }
+        }
+    }
+}
+
+void TestOcclusionCuller::hidesBoxBehindOccluder()
+{
+    OcclusionCuller culler(256, 128);
+    culler.beginFrame(perspectiveView());
+    culler.rasterizeOccluder(WALL);
+    culler.buildHierarchy();
+
+    QVERIFY(!culler.isVisible(Aabb{ glm::vec3(-2.0f, -2.0f, -52.0f), glm::vec3(2.0f, 2.0f, -48.0f) }));
+    QVERIFY(!culler.isVisible(Aabb{ glm::vec3(-1.0f, -1.0f, -15.0f), glm::vec3(1.0f, 1.0f, -12.0f) }));
+    QCOMPARE(culler.stats().tested, 2);
+    QCOMPARE(culler.stats().culled, 2);
+}
+
+void TestOcclusionCuller::keepsPartlyHiddenBox()
+{
+    OcclusionCuller culler(256, 128);
+    culler.beginFrame(perspectiveView());
+    culler.rasterizeOccluder(WALL);
+    culler.buildHierarchy();
+
+    // At distance 50 the wall's silhouette spans |x| < 25; this box pokes out of it
+    QVERIFY(culler.isVisible(Aabb{ glm::vec3(20.0f, -2.0f, -52.0f), glm::vec3(30.0f, 2.0f, -50.0f) }));
+    // Entirely beside the wall
+    QVERIFY(culler.isVisible(Aabb{ glm::vec3(35.0f, -2.0f, -52.0f), glm::vec3(40.0f, 2.0f, -50.0f) }));
+    QCOMPARE(culler.stats().culled, 0);
+}
+
+void TestOcclusionCuller::keepsBoxInFrontOfOccluder()
+{
+    OcclusionCuller culler(256, 128);
+    culler.beginFrame(perspectiveView());
+    culler.rasterizeOccluder(WALL);
+    culler.buildHierarchy();
+
+    QVERIFY(culler.isVisible(Aabb{ glm::vec3(-1.0f, -1.0f, -6.0f), glm::vec3(1.0f, 1.0f, -4.0f) }));
+    // Overlapping the wall's depth range is not enough to be hidden
+    QVERIFY(culler.isVisible(Aabb{ glm::vec3(-1.0f, -1.0f, -10.5f), glm::vec3(1.0f, 1.0f, -9.0f) }));
+}
+
+void TestOcclusionCuller::keepsBoxCrossingNearPlane()
+{
+    OcclusionCuller culler(256, 128);
+    culler.beginFrame(perspectiveView());
+    culler.rasterizeOccluder(WALL);
+    culler.buildHierarchy();
+
+    // Projection is unreliable once a corner is behind the near plane, so it must stay visible
+    QVERIFY(culler.isVisible(Aabb{ glm::vec3(-1.0f, -1.0f, -30.0f), glm::vec3(1.0f, 1.0f, 1.0f) }));
+    QVERIFY(culler.isVisible(Aabb{ glm::vec3(-1.0f, -1.0f, -0.5f), glm::vec3(1.0f, 1.0f, -0.05f) }));
+    QCOMPARE(culler.stats().culled, 0);
+}
+
+void TestOcclusionCuller::rejectsOccluderCrossingNearPlane()
+{
+    OcclusionCuller culler(256, 128);
+    culler.beginFrame(perspectiveView());
+    culler.rasterizeOccluder(Aabb{ glm::vec3(-5.0f, -5.0f, -20.0f), glm::vec3(5.0f, 5.0f, 2.0f) });
+    culler.rasterizeOccluder(Aabb{ glm::vec3(500.0f, -5.0f, -20.0f), glm::vec3(510.0f, 5.0f, -10.0f) });
+    QCOMPARE(culler.stats().occludersRejected, 2);
+    QCOMPARE(culler.stats().occludersRasterized, 0);
+
+    culler.buildHierarchy();
+    QCOMPARE(culler.depth(culler.levelCount() - 1)[0], 1.0f);
+    QVERIFY(culler.isVisible(Aabb{ glm::vec3(-2.0f, -2.0f, -52.0f), glm::vec3(2.0f, 2.0f, -48.0f) }));
+}
+
+void TestOcclusionCuller::picksLargestOccluders()
+{
+    OcclusionCuller culler(256, 128);
+    culler.beginFrame(perspectiveView());
+
+    const Aabb boxes[] = {
+        Aabb{ glm::vec3(20.0f, 0.0f, -101.0f), glm::vec3(21.0f, 1.0f, -100.0f) },   // Tiny
+        WALL,
+        Aabb{ glm::vec3(-5.0f, -5.0f, -20.0f), glm::vec3(5.0f, 5.0f, 2.0f) },       // Crosses the near plane
+    };
+    culler.rasterizeOccluders(boxes, 3, 1);
+    QCOMPARE(culler.stats().occludersRasterized, 1);
+    QCOMPARE(culler.stats().occludersRejected, 0);
+
+    culler.buildHierarchy();
+    QVERIFY(!culler.isVisible(Aabb{ glm::vec3(-2.0f, -2.0f, -52.0f), glm::vec3(2.0f, 2.0f, -48.0f) }));
+}
+
+QTEST_APPLESS_MAIN(TestOcclusionCuller)
+
+#include "tst_occlusionculler.moc"
@@ -0,0 +1,129 @@
+#include "TlsfAllocator.h"
+
+#include <QtTest>
+#include <map>
+#include <random>
+
+
+// ===================================================================
+// == TestTlsfAllocator Declaration
+// ===================================================================
+class TestTlsfAllocator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundsToGranularity();
+    void honoursAlignment();
+    void mergesNeighboursOnFree();
+    void failsWhenFull();
+    void randomChurnKeepsRangesDisjoint();
+};
+
+// ===================================================================
+// == TestTlsfAllocator Implementation
+// ===================================================================
+void TestTlsfAllocator::roundsToGranularity()
+{
+    TlsfAllocator allocator(4096);
+    const int range = allocator.allocate(100);
+    QVERIFY(range != TlsfAllocator::NULL_RANGE);
+    QCOMPARE(allocator.rangeSize(range), quint64(112));
+    QCOMPARE(allocator.usedBytes(), quint64(112));
+    QCOMPARE(allocator.freeBytes(), quint64(4096 - 112));
+    QCOMPARE(allocator.allocationCount(), 1);
+}
+
+void TestTlsfAllocator::honoursAlignment()
+{
+    TlsfAllocator allocator(1 << 20);
+    const int first = allocator.allocate(16);
+    const int aligned = allocator.allocate(64, 4096);
+    QVERIFY(first != TlsfAllocator::NULL_RANGE);
+    QVERIFY(aligned != TlsfAllocator::NULL_RANGE);
+    QCOMPARE(allocator.offset(aligned) % 4096, quint64(0));
+
+    // The padding in front of the aligned range is not charged to either allocation
+    QCOMPARE(allocator.usedBytes(), quint64(16 + 64));
+    const int filler = allocator.allocate(16);
+    QVERIFY(filler != TlsfAllocator::NULL_RANGE);
+    QVERIFY(allocator.offset(filler) < allocator.offset(aligned));
+}
+
+void TestTlsfAllocator::mergesNeighboursOnFree()
+{
+    TlsfAllocator allocator(4096);
+    const int a = allocator.allocate(1024);
+    const int b = allocator.allocate(1024);
+    const int c = allocator.allocate(1024);
+    QVERIFY(a != TlsfAllocator::NULL_RANGE && b != TlsfAllocator::NULL_RANGE && c != TlsfAllocator::NULL_RANGE);
+
+    allocator.free(a);
+    allocator.free(c);
+    QCOMPARE(allocator.freeRangeCount(), 2);
+    QCOMPARE(allocator.largestFreeRange(), quint64(2048));
+
+    allocator.free(b);
+    QVERIFY(allocator.isEmpty());
+    QCOMPARE(allocator.freeRangeCount(), 1);
+    QCOMPARE(allocator.largestFreeRange(), quint64(4096));
+}
+
+void TestTlsfAllocator::failsWhenFull()
+{
+    TlsfAllocator allocator(4096);
+    QVERIFY(allocator.allocate(4096) != TlsfAllocator::NULL_RANGE);
+    QCOMPARE(allocator.allocate(16), TlsfAllocator::NULL_RANGE);
+    QCOMPARE(allocator.allocate(0), TlsfAllocator::NULL_RANGE);
+    QCOMPARE(allocator.freeRangeCount(), 0);
+}
+
+void TestTlsfAllocator::randomChurnKeepsRangesDisjoint()
+{
+    TlsfAllocator allocator(16ull * 1024 * 1024);
+    std::mt19937 rng(5);
+    std::map<quint64, int> live;   // Offset -> range
+
+    for (int step = 0; step < 20000; ++step) {
+        if (live.size() < 500 && rng() % 3 != 0) {
+            const quint64 size = 16 + rng() % 50000;
+            const quint64 alignment = quint64(1) << (4 + rng() % 6);
+            const int range = allocator.allocate(size, alignment);
+            if (range == TlsfAllocator::NULL_RANGE) continue;
+
+            const quint64 offset = allocator.offset(range);
+            QCOMPARE(offset % alignment, quint64(0));
+            QVERIFY(allocator.rangeSize(range) >= size);
+            QVERIFY(offset + allocator.rangeSize(range) <= allocator.size());
+
+            // Neither neighbour by offset may overlap the new range
+            const auto next = live.lower_bound(offset);
+            if (next != live.end()) {
+                QVERIFY(offset + allocator.rangeSize(range) <= next->first);
+            }
+            if (next != live.begin()) {
+                const auto prev = std::prev(next);
+                QVERIFY(prev->first + allocator.rangeSize(prev->second) <= offset);
+            }
+            live.emplace(offset, range);
+        }
+        else if (!live.empty()) {
+            auto it = live.begin();
+            std::advance(it, rng() % live.size());
+            allocator.free(it->second);
+            live.erase(it);
+        }
+    }
+
+    for (const auto& entry : live) {
+        allocator.free(entry.second);
+    }
+    QVERIFY(allocator.isEmpty());
+    QCOMPARE(allocator.usedBytes(), quint64(0));
+    QCOMPARE(allocator.freeRangeCount(), 1);
+    QCOMPARE(allocator.largestFreeRange(), allocator.size());
+}
+
+QTEST_APPLESS_MAIN(TestTlsfAllocator)
+
+#include "tst_tlsfallocator.moc"